@@ -3,69 +3,192 @@
  * Utiliza display OLED SSD1306, matriz de LEDs RGB, botões e joystick
  */
 
+ #include <string.h>
  #include "General.h"
  #include "Leds.h"
  #include "ssd1306.h"
- #include "Font.h"
+ #include "Widgets.h"
+ #include "Conditioning.h"
+ #include "Zones.h"
+ #include "Scheduler.h"
+ #include "Snapshot.h"
+ #include "InputEvents.h"
+ #include "Debounce.h"
+ #include "Telemetry.h"
+ #include "History.h"
+ #include "Profiling.h"
+ #include "Console.h"
+ #include "Hal.h"
+ #include "Patterns.h"
  
  // ==================== DEFINIÇÃO DE ESTRUTURAS ====================
  
+ /**
+  * Grandeza ajustada pelo joystick; os controles são mutuamente exclusivos
+  */
+ typedef enum {
+     CONTROL_TEMPERATURE = QUANTITY_TEMPERATURE,
+     CONTROL_HUMIDITY = QUANTITY_HUMIDITY,
+     CONTROL_BRIGHTNESS = QUANTITY_BRIGHTNESS,
+     CONTROL_NONE = QUANTITY_COUNT
+ } ControlMode;
+ 
  /**
   * Estrutura para armazenar os estados do sistema
+  * Alterada somente no contexto principal, nunca em interrupções
   */
  typedef struct {
-     bool temperatureControl;   // Controle de temperatura ativo
-     bool humidityControl;      // Controle de umidade ativo
-     bool brightnessControl;    // Controle de luminosidade ativo
+     ControlMode control;       // Grandeza em ajuste
      bool soundAlert;           // Alerta sonoro ativo
-     uint8_t temperature;       // Valor atual da temperatura
-     uint8_t humidity;          // Valor atual da umidade
-     uint8_t brightness;        // Valor atual da luminosidade
+     uint8_t zone;              // Zona selecionada (mostrada e ajustada pelo joystick)
  } SystemState;
  
+ /**
+  * Saídas dos indicadores para uma severidade combinada
+  */
+ typedef struct {
+     bool redLed;                     // LED vermelho aceso
+     bool greenLed;                   // LED verde aceso
+     bool soundAlert;                 // Alarme sonoro ativo
+     const Animation *animation;      // Animação da matriz (NULL usa o padrão estático)
+     int patternCode;                 // Padrão estático da matriz
+ } IndicatorOutput;
+ 
  // ==================== VARIÁVEIS GLOBAIS ====================
  
- refs pio;                               // Referência do PIO para controle da matriz de LEDs
- uint32_t valorLed;                      // Valor do LED a ser enviado para a matriz
  RGB color[3];                           // Configuração de cores dos LEDs (RGB)
- double *drawing;                        // Ponteiro para o desenho atual (sequência de LEDs)
+ Pattern drawing;                        // Padrão atual da matriz (2 bits por LED)
  ssd1306_t ssd;                          // Estrutura de controle do display OLED
  
- // Variáveis para debounce dos botões
- static volatile uint32_t lastTimeA = 0; // Tempo da última interrupção do botão A
- static volatile uint32_t lastTimeB = 0; // Tempo da última interrupção do botão B
- static volatile uint32_t lastTimeJ = 0; // Tempo da última interrupção do botão Joystick
+ // Campos numéricos do display (apenas os que mudam são redesenhados)
+ static NumericField temperatureField;
+ static NumericField humidityField;
+ static NumericField brightnessField;
+ static NumericField zoneField;
+ 
+ // Condicionamento do eixo X: mediana de 5 amostras contra picos e média móvel de 8
+ static FilterStage vrxStages[2];
+ static FilterPipeline vrxPipeline = { vrxStages, 2 };
+ static uint16_t vrxCursor = 0;                       // Posição da última leitura no anel do ADC
+ static uint16_t vrxFiltered = (LOWEST_AXIS_VALUE + HIGHEST_AXIS_VALUE) / 2;
+ 
+ // Condicionamento do eixo Y: média exponencial com alfa = 1/8, que tira o ruído
+ // da seleção de zona sem o atraso de uma janela longa
+ static FilterStage vryStages[1];
+ static FilterPipeline vryPipeline = { vryStages, 1 };
+ static uint16_t vryCursor = 0;
+ static uint16_t vryFiltered = (LOWEST_AXIS_VALUE + HIGHEST_AXIS_VALUE) / 2;
+ 
+ // Última leitura do joystick, produzida pela tarefa de sensores e usada pela de controle
+ static uint16_t vrxValue;
+ static uint16_t vryValue;
+ 
+ // Tarefa da matriz, sinalizada quando a severidade combinada muda ou quando
+ // um quadro ficou pendente com a fila da matriz cheia
+ static int matrixTask;
+ static bool matrixStale = false;        // Severidade ainda não aplicada à matriz
+ 
+ // Histórico na flash aberto; sem ele a tarefa de histórico não é registrada
+ static bool historyReady = false;
+ 
+ #if DUAL_CORE
+ // Estado publicado pelo núcleo 0 (controle) para o núcleo 1 (display)
+ static SnapshotChannel displayChannel;
+ #endif
+ 
+ // Valores e classificação de todas as zonas, e última severidade aplicada aos indicadores
+ static ZoneState zones;
+ static const uint8_t zoneDefaults[QUANTITY_COUNT] = {
+     [QUANTITY_TEMPERATURE] = 25,
+     [QUANTITY_HUMIDITY] = 60,
+     [QUANTITY_BRIGHTNESS] = 50,
+ };
+ static Severity appliedSeverity = SEVERITY_COUNT;   // Nenhuma aplicada ainda
+ 
+ // Saídas por severidade, na ordem de Severity: verde, amarelo (vermelho + verde) e vermelho
+ static const IndicatorOutput indicatorOutputs[SEVERITY_COUNT] = {
+     { false, true,  false, NULL,        0 },  // Normal
+     { true,  true,  false, NULL,        1 },  // Alerta
+     { true,  false, true,  &alertPulse, 0 },  // Crítico
+ };
+ 
+ // Botões e o controle que cada um alterna
+ static const struct {
+     uint8_t gpio;
+     ControlMode mode;
+ } controlButtons[] = {
+     { BUTTON_A, CONTROL_TEMPERATURE },
+     { BUTTON_B, CONTROL_HUMIDITY },
+     { JOYSTICK_BUTTON, CONTROL_BRIGHTNESS },
+ };
+ 
+ // Fator em Q16 de cada grandeza para converter a posição do eixo X
+ static const uint32_t axisScale[QUANTITY_COUNT] = {
+     [QUANTITY_TEMPERATURE] = AXIS_SCALE_Q16(TEMP_AXIS_MAX),
+     [QUANTITY_HUMIDITY] = AXIS_SCALE_Q16(HUMIDITY_AXIS_MAX),
+     [QUANTITY_BRIGHTNESS] = AXIS_SCALE_Q16(BRIGHTNESS_AXIS_MAX),
+ };
+ 
+ // Nomes das grandezas no console, na ordem de Quantity; o último é CONTROL_NONE
+ static const char *const quantityNames[QUANTITY_COUNT + 1] = {
+     [QUANTITY_TEMPERATURE] = "temp",
+     [QUANTITY_HUMIDITY] = "umid",
+     [QUANTITY_BRIGHTNESS] = "lum",
+     [QUANTITY_COUNT] = "nenhum",
+ };
+ 
+ static const char *const severityNames[SEVERITY_COUNT] = { "normal", "alerta", "critico" };
  
  // Estado do sistema
- static volatile SystemState systemState = {
-     .temperatureControl = false,
-     .humidityControl = false,
-     .brightnessControl = false,
+ static SystemState systemState = {
+     .control = CONTROL_NONE,
      .soundAlert = false,
-     .temperature = 25,
-     .humidity = 60,
-     .brightness = 50
+     .zone = 0
  };
  
  // ==================== PROTÓTIPOS DE FUNÇÕES ====================
  
  // Configuração e inicialização
  void InitSystem(void);                                   // Inicializa todos os componentes do sistema
- void ConfigureInputs(void);                              // Configura entradas (botões e joystick)
- void ConfigureOutputs(void);                             // Configura saídas (LEDs e buzzer)
+ void ConfigureInputs(void);                              // Inicia a leitura dos botões com debounce
  void ConfigureDisplay(void);                             // Configura o display OLED
+ void DrawDisplayLayout(void);                            // Desenha a parte estática da tela
  void SetDefaultLedColors(void);                          // Define as cores padrão dos LEDs
  
- // Interrupções e controle de entrada
- void SetInterruption(int pin);                           // Configura interrupção para um pino
- void HandleInterruption(uint gpio, uint32_t events);     // Manipula interrupções dos botões
+ // Controle de entrada
+ void ProcessInputEvents(void);                           // Aplica os eventos dos botões ao modo de controle
  void ReadJoystick(uint16_t *vrx_value, uint16_t *vry_value); // Lê valores do joystick
+ uint16_t ReadAxis(uint8_t input, FilterPipeline *pipeline, uint16_t *cursor, uint16_t *filtered); // Condiciona um eixo
+ 
+ // Tarefas do escalonador
+ void SensorTask(void);                                   // Lê o joystick
+ void ControlTask(void);                                  // Atualiza zonas, classificação e alarme
+ void DisplayTask(void);                                  // Atualiza o display no próprio núcleo 0
+ void DisplayCore(void);                                  // Laço do núcleo 1: desenha cada estado publicado
+ void RecordTelemetry(void);                              // Registra o estado atual no anel de telemetria
+ void HistoryTask(void);                                  // Acrescenta os valores das zonas ao histórico na flash
  
  // Funções de atualização
  void UpdateSystemState(uint16_t vrx_value);               // Atualiza o estado do sistema com base no joystick
+ void UpdateZoneSelection(uint16_t vry_value);             // Troca a zona selecionada com o eixo Y
  void UpdateDrawing(int patternCode);                      // Atualiza o padrão na matriz de LEDs
- void UpdateDisplay(void);                                 // Atualiza as informações no display OLED
+ void CaptureSnapshot(DisplaySnapshot *snapshot);          // Copia o estado mostrado no display
+ void UpdateDisplay(const DisplaySnapshot *snapshot);      // Atualiza as informações no display OLED
  void UpdateIndicators(void);                              // Atualiza LEDs indicadores e alarme
+ void UpdateMatrix(void);                                  // Aplica à matriz o padrão da severidade atual
+ void RetryMatrixFrame(void);                              // Reenvia o quadro recusado pela fila da matriz cheia
+ 
+ // Comandos do console
+ void CommandGet(int argc, char **argv);                   // Mostra as faixas de uma grandeza
+ void CommandSet(int argc, char **argv);                   // Troca as faixas de uma grandeza
+ void CommandMode(int argc, char **argv);                  // Força o modo de controle
+ void CommandState(int argc, char **argv);                 // Mostra o estado do sistema
+ void CommandStats(int argc, char **argv);                 // Mostra as estatísticas do escalonador
+ void CommandProfile(int argc, char **argv);               // Mostra ou zera o perfil dos estágios
+ void CommandPattern(int argc, char **argv);               // Desenha um padrão na matriz
+ void CommandGlyph(int argc, char **argv);                 // Desenha um símbolo de estado na matriz
+ void CommandColor(int argc, char **argv);                 // Troca a cor principal da matriz
+ void CommandTelemetry(int argc, char **argv);             // Liga ou desliga a telemetria binária
  
  // ==================== FUNÇÃO PRINCIPAL ====================
  
@@ -74,108 +197,205 @@
      // Inicializa componentes do sistema
      InitSystem();
      
-     uint16_t vrx_value, vry_value;
+     // Cada subsistema roda no próprio período; entre os prazos o núcleo dorme
+     AddTask("sensores", SensorTask, SENSOR_PERIOD_US, 0);
+     AddTask("controle", ControlTask, CONTROL_PERIOD_US, 1);
+     matrixTask = AddTask("matriz", UpdateMatrix, TASK_ON_EVENT, 2);
+ #if !DUAL_CORE
+     AddTask("display", DisplayTask, DISPLAY_PERIOD_US, 3);
+ #endif
+     AddTask("telemetria", DrainTelemetry, TELEMETRY_PERIOD_US, 4);
+     if (historyReady)
+         AddTask("historico", HistoryTask, HISTORY_PERIOD_US, 5);
+     AddTask("console", ConsoleTask, CONSOLE_POLL_US, 6);
+     
+     RunScheduler();
+ }
+ 
+ // ==================== IMPLEMENTAÇÃO DAS FUNÇÕES ====================
+ 
+ /**
+  * Tarefa de sensores: lê o joystick, condicionando as amostras novas
+  */
+ void SensorTask(void)
+ {
+     PROFILE_BEGIN(READ_JOYSTICK);
+     ReadJoystick(&vrxValue, &vryValue);
+     PROFILE_END(READ_JOYSTICK);
+ }
+ 
+ /**
+  * Tarefa de controle: aplica os botões, seleciona a zona, atualiza seus valores, classifica
+  * todas as zonas e controla o buzzer
+  */
+ void ControlTask(void)
+ {
+     PROFILE_BEGIN(CONTROL_TASK);
+     
+     ProcessInputEvents();
+     UpdateZoneSelection(vryValue);
+     
+     PROFILE_BEGIN(UPDATE_SYSTEM_STATE);
+     UpdateSystemState(vrxValue);
+     PROFILE_END(UPDATE_SYSTEM_STATE);
+     
+     PROFILE_BEGIN(UPDATE_INDICATORS);
+     UpdateIndicators();
+     PROFILE_END(UPDATE_INDICATORS);
+     
+     HalSetBuzzer(systemState.soundAlert ? 20000 : 0);
+     RecordTelemetry();
+     
+ #if DUAL_CORE
+     // Entrega o estado ao núcleo do display sem esperar pelo barramento I2C
+     DisplaySnapshot snapshot;
+     CaptureSnapshot(&snapshot);
+     PublishSnapshot(&displayChannel, &snapshot);
+ #endif
+     
+     PROFILE_END(CONTROL_TASK);
+ }
+ 
+ /**
+  * Tarefa de display (modo de um núcleo): desenha e envia o estado atual
+  */
+ void DisplayTask(void)
+ {
+     DisplaySnapshot snapshot;
+     CaptureSnapshot(&snapshot);
+     UpdateDisplay(&snapshot);
+ }
+ 
+ #if DUAL_CORE
+ /**
+  * Laço do núcleo 1: dono do display e do I2C. Dorme até o núcleo 0 publicar
+  * um novo estado, então o tempo de barramento não afeta o laço de controle
+  */
+ void DisplayCore(void)
+ {
+     ConfigureDisplay();
+     
+     DisplaySnapshot snapshot;
+     uint32_t sequence = 0;
      
-     // Loop principal
      while (true)
      {
-         // Lê valores do joystick
-         ReadJoystick(&vrx_value, &vry_value);
-         
-         // Atualiza estados do sistema baseado nos controles ativos
-         UpdateSystemState(vrx_value);
-         
-         // Atualiza indicadores visuais e sonoros
-         UpdateIndicators();
-         
-         // Atualiza display OLED
-         UpdateDisplay();
+         if (!ReadSnapshot(&displayChannel, &snapshot, &sequence))
+         {
+             HalSleepUntil(UINT64_MAX);
+             continue;
+         }
          
-         // Controla o buzzer
-         pwm_set_gpio_level(BUZZER_A, systemState.soundAlert ? 20000 : 0);
+         UpdateDisplay(&snapshot);
      }
  }
+ #endif
  
- // ==================== IMPLEMENTAÇÃO DAS FUNÇÕES ====================
+ /**
+  * Tarefa de histórico: acrescenta os valores de todas as zonas ao log na flash
+  */
+ void HistoryTask(void)
+ {
+     AppendHistory(&zones.values[0][0], HalTimeUs() / 1000000);
+ }
  
  /**
   * Inicializa todos os componentes do sistema
   */
  void InitSystem(void)
  {
-     // Inicializa o PIO para controle da matriz de LEDs
-     pio = InitPIO();
-     
-     // Configura entradas, saídas e interrupções
+     // Periféricos da placa: matriz de LEDs, botões, LEDs, amostragem do ADC e buzzer
+     HalInit();
      ConfigureInputs();
-     ConfigureOutputs();
      
-     // Configura ADC para joystick
-     adc_init();
-     adc_gpio_init(VRX_PIN);
-     adc_gpio_init(VRY_PIN);
+     // Condicionamento dos eixos do joystick e estado inicial das zonas
+     InitMedianFilter(&vrxStages[0], 5);
+     InitMovingAverage(&vrxStages[1], 3);
+     InitExpAverage(&vryStages[0], 3);
+     InitZones(&zones, zoneDefaults);
+     
+     // Console de comandos na serial
+     static const ConsoleCommand commands[] = {
+         { "get", "<temp|umid|lum>", CommandGet },
+         { "set", "<temp|umid|lum> <min normal> <max normal> <max alerta> <histerese>", CommandSet },
+         { "mode", "<temp|umid|lum|nenhum>", CommandMode },
+         { "state", "", CommandState },
+         { "stats", "", CommandStats },
+         { "profile", "[reset]", CommandProfile },
+         { "pattern", "<0-2>", CommandPattern },
+         { "glyph", "<0-19>", CommandGlyph },
+         { "color", "<r> <g> <b>", CommandColor },
+         { "telemetry", "[on|off]", CommandTelemetry },
+     };
      
-     // Define as cores padrão para a matriz de LEDs
+     InitConsole(commands, count_of(commands));
+     
+     // Define o brilho global e as cores padrão para a matriz de LEDs
+     SetMatrixBrightness(MATRIX_DEFAULT_BRIGHTNESS);
      SetDefaultLedColors();
      
      // Inicializa desenho padrão (código 554)
      drawing = Drawing(554);
-     Draw(drawing, valorLed, pio, color);
+     Draw(drawing, color);
      
+ #if DUAL_CORE
+     // O núcleo 1 assume o display OLED e o I2C. HalLaunchCore1 só retorna
+     // depois que ele aceitar ser pausado, então a flash já pode ser gravada
+     HalLaunchCore1(DisplayCore);
+ #else
      // Configura display OLED
      ConfigureDisplay();
+ #endif
      
-     // Inicializa PWM para buzzer
-     pwm_init_gpio(BUZZER_A);
+     // Retoma o histórico na flash depois do último trecho gravado
+     historyReady = InitHistory(HalHistoryFlash(), HalTimeUs() / 1000000);
+     if (!historyReady)
+         printf("historico: flash indisponivel, registro desativado\n");
  }
  
  /**
-  * Configura as entradas do sistema (botões e joystick)
+  * Inicia a leitura dos botões; os pinos já foram configurados por HalInit
   */
  void ConfigureInputs(void)
  {
-     // Configura botões A e B
-     SetInput(BUTTON_A);
-     SetInterruption(BUTTON_A);
-     
-     SetInput(BUTTON_B);
-     SetInterruption(BUTTON_B);
-     
-     // Configura botão do joystick
-     SetInput(JOYSTICK_BUTTON);
-     SetInterruption(JOYSTICK_BUTTON);
+     // Amostragem periódica com debounce de todos os botões juntos
+     InitDebounce((1u << BUTTON_A) | (1u << BUTTON_B) | (1u << JOYSTICK_BUTTON));
  }
  
  /**
-  * Configura as saídas do sistema (LEDs)
+  * Configura o display OLED
   */
- void ConfigureOutputs(void)
+ void ConfigureDisplay(void)
  {
-     SetOutput(RED_LED);
-     SetOutput(GREEN_LED);
+     // Inicializa o I2C a 400kHz e o display OLED
+     HalDisplayInit(&ssd);
+     
+     // Desenha os rótulos uma única vez; o primeiro envio leva o quadro completo
+     DrawDisplayLayout();
+     HalDisplaySend(&ssd);
  }
  
  /**
-  * Configura o display OLED
+  * Desenha a parte estática da tela e posiciona os campos numéricos
+  * Linhas alinhadas às páginas do display (múltiplos de 8) para o desenho por bytes
   */
- void ConfigureDisplay(void)
+ void DrawDisplayLayout(void)
  {
-     // Inicializa comunicação I2C com o display OLED a 400kHz
-     i2c_init(I2C_PORT, 400 * 1000);
+     ssd1306_fill(&ssd, false);
      
-     // Configuração dos pinos SDA e SCL
-     gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
-     gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
-     gpio_pull_up(I2C_SDA);
-     gpio_pull_up(I2C_SCL);
+     // Zona selecionada no título, com marcador quando a zona está crítica
+     DrawLabel(&ssd, "ZONA", 32, 0);
+     InitNumericField(&zoneField, 72, 0, 3, 120);
      
-     // Inicializa o display OLED
-     ssd1306_init(&ssd, WIDTH, HEIGHT, false, ADRESS, I2C_PORT);
-     ssd1306_config(&ssd);
-     ssd1306_send_data(&ssd);
+     // Rótulos à esquerda, 3 dígitos a partir da coluna 96 e marcador na coluna 120
+     DrawLabel(&ssd, "TEMPERATURA", 0, 16);
+     InitNumericField(&temperatureField, 96, 16, 3, 120);
      
-     // Atualização inicial do display
-     UpdateDisplay();
+     DrawLabel(&ssd, "UMIDADE", 0, 32);
+     InitNumericField(&humidityField, 96, 32, 3, 120);
+     
+     DrawLabel(&ssd, "LUMINOSIDADE", 0, 48);
+     InitNumericField(&brightnessField, 96, 48, 3, 120);
  }
  
  /**
@@ -183,10 +403,10 @@
   */
  void SetDefaultLedColors(void)
  {
-     // Define cor principal (índice 0)
-     color[0].red = 2;
-     color[0].green = 4;
-     color[0].blue = 8;
+     // Define cor principal (índice 0), antes da correção de gama (resulta em 2, 4, 8)
+     color[0].red = 28;
+     color[0].green = 39;
+     color[0].blue = 53;
      
      // As outras cores podem ser descomentas se necessário
      /*
@@ -201,69 +421,32 @@
  }
  
  /**
-  * Configura a interrupção para um pino específico
-  * @param pin Número do pino GPIO a ser configurado
+  * Consome os eventos dos botões, já sem ruído, em ordem e troca o modo de
+  * controle em uma única escrita
+  * Toque: o botão alterna o próprio controle e desativa os demais
+  * Soltura e toque longo não têm ação
   */
- void SetInterruption(int pin)
+ void ProcessInputEvents(void)
  {
-     // Ativa interrupção de borda de descida para o pino
-     gpio_set_irq_enabled(pin, GPIO_IRQ_EDGE_FALL, true);
-     
-     // Registra a função de callback para interrupções
-     gpio_set_irq_callback(&HandleInterruption);
+     InputEvent event;
+     ControlMode control = systemState.control;
      
-     // Ativa interrupções no banco de GPIOs
-     irq_set_enabled(IO_IRQ_BANK0, true);
- }
- 
- /**
-  * Manipula as interrupções dos botões com debounce
-  * @param gpio Pino que gerou a interrupção
-  * @param events Tipo de evento ocorrido
-  */
- void HandleInterruption(uint gpio, uint32_t events)
- {
-     uint32_t currentTime = to_us_since_boot(get_absolute_time());
-     
-     // Botão A (Temperatura) - GPIO 5
-     if (gpio == BUTTON_A && currentTime - lastTimeA > 250000)
-     {
-         lastTimeA = currentTime;
-         systemState.temperatureControl = !systemState.temperatureControl;
-         
-         // Desativa outros controles quando este é ativado
-         if (systemState.temperatureControl)
-         {
-             systemState.humidityControl = false;
-             systemState.brightnessControl = false;
-         }
-     }
-     // Botão B (Umidade) - GPIO 6
-     else if (gpio == BUTTON_B && currentTime - lastTimeB > 250000)
+     while (PopInputEvent(&event))
      {
-         lastTimeB = currentTime;
-         systemState.humidityControl = !systemState.humidityControl;
-         
-         // Desativa outros controles quando este é ativado
-         if (systemState.humidityControl)
-         {
-             systemState.temperatureControl = false;
-             systemState.brightnessControl = false;
-         }
-     }
-     // Botão do Joystick (Luminosidade) - GPIO 22
-     else if (gpio == JOYSTICK_BUTTON && currentTime - lastTimeJ > 250000)
-     {
-         lastTimeJ = currentTime;
-         systemState.brightnessControl = !systemState.brightnessControl;
-         
-         // Desativa outros controles quando este é ativado
-         if (systemState.brightnessControl)
+         for (uint i = 0; i < count_of(controlButtons); i++)
          {
-             systemState.temperatureControl = false;
-             systemState.humidityControl = false;
+             if (controlButtons[i].gpio != event.gpio)
+                 continue;
+             
+             ControlMode mode = controlButtons[i].mode;
+             
+             if (event.type == INPUT_PRESS)
+                 control = control == mode ? CONTROL_NONE : mode;
+             break;
          }
      }
+     
+     systemState.control = control;
  }
  
  /**
@@ -272,134 +455,386 @@
   */
  void UpdateDrawing(int patternCode)
  {
+     // Padrões estáticos substituem qualquer animação em execução.
+     // Draw ignora o envio quando o quadro resultante é igual ao anterior
+     StopAnimation();
      drawing = Drawing(patternCode);
-     Draw(drawing, valorLed, pio, color);
+     Draw(drawing, color);
  }
  
  /**
-  * Atualiza as informações mostradas no display OLED
+  * Copia o estado mostrado no display: a zona selecionada e os controles ativos
+  * @param snapshot Destino da cópia
   */
- void UpdateDisplay(void)
+ void CaptureSnapshot(DisplaySnapshot *snapshot)
  {
-     // Limpa o display
-     ssd1306_fill(&ssd, false);
-     
-     char buffer[32]; // Buffer para strings formatadas
+     uint8_t zone = systemState.zone;
      
-     // Título
-     ssd1306_draw_string(&ssd, "DADOS", 45, 5);
-     
-     // Informações com indicadores visuais de estado de controle
-     sprintf(buffer, "TEMPERATURA %d%s", systemState.temperature, 
-             systemState.temperatureControl ? " *" : "");
-     ssd1306_draw_string(&ssd, buffer, 5, 20);
+     snapshot->zone = zone;
+     for (int q = 0; q < QUANTITY_COUNT; q++)
+         snapshot->values[q] = zones.values[q][zone];
+     snapshot->zoneCritical = ZoneFlag(zones.criticalFlags, zone);
+     snapshot->control = systemState.control;
+ }
+ 
+ /**
+  * Atualiza as informações mostradas no display OLED
+  * @param snapshot Estado a mostrar
+  */
+ void UpdateDisplay(const DisplaySnapshot *snapshot)
+ {
+     PROFILE_BEGIN(UPDATE_DISPLAY);
      
-     sprintf(buffer, "UMIDADE %d%s", systemState.humidity, 
-             systemState.humidityControl ? " *" : "");
-     ssd1306_draw_string(&ssd, buffer, 5, 35);
+     // Redesenha apenas os campos cujo valor ou marcador de controle mudou
+     UpdateNumericField(&ssd, &zoneField, snapshot->zone + 1, snapshot->zoneCritical);
+     UpdateNumericField(&ssd, &temperatureField, snapshot->values[QUANTITY_TEMPERATURE], snapshot->control == CONTROL_TEMPERATURE);
+     UpdateNumericField(&ssd, &humidityField, snapshot->values[QUANTITY_HUMIDITY], snapshot->control == CONTROL_HUMIDITY);
+     UpdateNumericField(&ssd, &brightnessField, snapshot->values[QUANTITY_BRIGHTNESS], snapshot->control == CONTROL_BRIGHTNESS);
      
-     sprintf(buffer, "LUMINOSIDADE %d%s", systemState.brightness, 
-             systemState.brightnessControl ? " *" : "");
-     ssd1306_draw_string(&ssd, buffer, 5, 50);
+     // Envia as regiões que mudaram por DMA, sem bloquear quem chamou.
+     // Se o quadro anterior ainda está em envio, as alterações ficam para a próxima chamada
+     HalDisplaySend(&ssd);
      
-     // Atualiza o display
-     ssd1306_send_data(&ssd);
+     PROFILE_END(UPDATE_DISPLAY);
  }
  
  /**
-  * Lê os valores do joystick através do ADC
+  * Lê os valores do joystick, amostrados continuamente pelo ADC
+  * Cada eixo passa pelo seu condicionamento com todas as amostras novas desde a última leitura
   * @param vrx_value Ponteiro para armazenar o valor do eixo X
   * @param vry_value Ponteiro para armazenar o valor do eixo Y
   */
  void ReadJoystick(uint16_t *vrx_value, uint16_t *vry_value)
  {
-     // Lê valor do eixo X (ADC1)
-     adc_select_input(1);
-     *vrx_value = adc_read();
+     *vrx_value = ReadAxis(VRX_INPUT, &vrxPipeline, &vrxCursor, &vrxFiltered);
+     *vry_value = ReadAxis(VRY_INPUT, &vryPipeline, &vryCursor, &vryFiltered);
+ }
+ 
+ /**
+  * Condiciona as amostras de um eixo recebidas desde a última leitura
+  * @param input Entrada do ADC do eixo
+  * @param pipeline Estágios de condicionamento do eixo
+  * @param cursor Posição da última leitura no anel do ADC
+  * @param filtered Último valor condicionado, mantido quando não há amostras novas
+  * @return Valor condicionado mais recente
+  */
+ uint16_t ReadAxis(uint8_t input, FilterPipeline *pipeline, uint16_t *cursor, uint16_t *filtered)
+ {
+     uint16_t raw[HAL_ADC_BLOCK];
+     int32_t block[HAL_ADC_BLOCK];
      
-     // Lê valor do eixo Y (ADC0)
-     adc_select_input(0);
-     *vry_value = adc_read();
+     uint16_t count = HalAdcRead(input, raw, HAL_ADC_BLOCK, cursor);
+     if (count > 0)
+     {
+         for (uint16_t i = 0; i < count; i++)
+             block[i] = raw[i];
+         PipelineProcess(pipeline, block, count);
+         *filtered = block[count - 1];
+     }
+     
+     return *filtered;
  }
  
  /**
-  * Atualiza o estado do sistema com base nos valores do joystick
-  * @param vrx_value Valor atual do eixo X do joystick
+  * Avança ou volta a zona selecionada enquanto o eixo Y estiver fora da zona morta
+  * Segurar o joystick repete a troca a cada ZONE_REPEAT_MS
+  * @param vry_value Valor atual do eixo Y do joystick
   */
- void UpdateSystemState(uint16_t vrx_value)
+ void UpdateZoneSelection(uint16_t vry_value)
  {
-     // Calcula o intervalo útil do joystick
-     uint16_t range = HIGHEST_AXIS_VALUE - LOWEST_AXIS_VALUE;
+     static uint64_t nextStep;
+     
+     int step = vry_value > ZONE_AXIS_HIGH ? 1 : vry_value < ZONE_AXIS_LOW ? -1 : 0;
      
-     // Atualiza valores com base nos controles ativos
-     if (systemState.temperatureControl)
+     // Joystick centralizado: a próxima inclinação troca a zona imediatamente
+     if (step == 0)
      {
-         systemState.temperature = (vrx_value - LOWEST_AXIS_VALUE) * 50 / range;
+         nextStep = 0;
+         return;
      }
      
-     if (systemState.humidityControl)
+     uint64_t now = HalTimeUs();
+     if (now >= nextStep)
      {
-         systemState.humidity = (vrx_value - LOWEST_AXIS_VALUE) * 60 / range;
+         systemState.zone = (systemState.zone + ZONE_COUNT + step) % ZONE_COUNT;
+         nextStep = now + ZONE_REPEAT_MS * 1000;
      }
+ }
+ 
+ /**
+  * Atualiza os valores da zona selecionada com base no joystick
+  * @param vrx_value Valor atual do eixo X do joystick
+  */
+ void UpdateSystemState(uint16_t vrx_value)
+ {
+     // Posição do eixo dentro do intervalo útil do joystick
+     uint32_t position = vrx_value < LOWEST_AXIS_VALUE ? 0
+                       : vrx_value > HIGHEST_AXIS_VALUE ? AXIS_RANGE
+                       : vrx_value - LOWEST_AXIS_VALUE;
      
-     if (systemState.brightnessControl)
+     ControlMode control = systemState.control;
+     
+     // Atualiza o valor da grandeza em controle (multiplicação em Q16, sem divisão)
+     if (control != CONTROL_NONE)
      {
-         systemState.brightness = (vrx_value - LOWEST_AXIS_VALUE) * 70 / range;
+         zones.values[control][systemState.zone] = (position * axisScale[control]) >> 16;
      }
  }
  
  /**
-  * Atualiza os indicadores de estado com base nos valores atuais
-  * Controla LEDs indicadores, padrão da matriz e alarme sonoro
+  * Atualiza os indicadores de estado com base nos valores atuais de todas as zonas
+  * Controla LEDs indicadores e alarme sonoro pela zona mais grave
+  * As saídas só são reaplicadas quando a severidade combinada muda, e a matriz
+  * é atualizada pela sua própria tarefa
   */
  void UpdateIndicators(void)
  {
-     uint8_t temp = systemState.temperature;
-     uint8_t hum = systemState.humidity;
-     uint8_t bri = systemState.brightness;
+     Severity severity = EvaluateZones(&zones);
      
-     // Verifica condição crítica alta (LED vermelho + alarme)
-     if (temp > TEMP_MEDIUM_MAX || hum > HUMIDITY_MEDIUM_MAX || bri > BRIGHTNESS_MEDIUM_MAX)
+     if (severity != appliedSeverity)
      {
-         gpio_put(RED_LED, true);
-         gpio_put(GREEN_LED, false);
-         UpdateDrawing(2);  // Padrão de alerta crítico
-         systemState.soundAlert = true;
+         const IndicatorOutput *output = &indicatorOutputs[severity];
+         appliedSeverity = severity;
+         
+         HalSetLed(RED_LED, output->redLed);
+         HalSetLed(GREEN_LED, output->greenLed);
+         systemState.soundAlert = output->soundAlert;
+         
+         matrixStale = true;
+         SignalTask(matrixTask);
      }
-     // Verifica condição crítica baixa (LED vermelho + alarme)
-     else if (temp < TEMP_NORMAL_MIN || hum < HUMIDITY_NORMAL_MIN || bri < BRIGHTNESS_NORMAL_MIN)
+ }
+ 
+ /**
+  * Registra o estado atual no anel de telemetria, sem esperar pela porta serial
+  * O envio é feito pela tarefa de telemetria
+  */
+ void RecordTelemetry(void)
+ {
+     uint8_t zone = systemState.zone;
+     TelemetryRecord record = {
+         .timeUs = HalTimeUs(),
+         .zone = zone,
+         .control = systemState.control,
+         .severity = appliedSeverity,
+         .flags = systemState.soundAlert ? TELEMETRY_FLAG_SOUND_ALERT : 0,
+     };
+     
+     for (int q = 0; q < QUANTITY_COUNT; q++)
+         record.values[q] = zones.values[q][zone];
+     
+     PushTelemetry(&record);
+ }
+ 
+ /**
+  * Aplica à matriz a animação ou o padrão da última severidade combinada, se
+  * ela mudou, e reenvia o quadro que tenha ficado pendente
+  */
+ void UpdateMatrix(void)
+ {
+     if (matrixStale)
      {
-         gpio_put(RED_LED, true);
-         gpio_put(GREEN_LED, false);
-         UpdateDrawing(1);  // Padrão de alerta
-         systemState.soundAlert = true;
+         const IndicatorOutput *output = &indicatorOutputs[appliedSeverity];
+         matrixStale = false;
+         
+         PROFILE_BEGIN(UPDATE_DRAWING);
+         if (output->animation)
+             PlayAnimation(output->animation);
+         else
+             UpdateDrawing(output->patternCode);
+         PROFILE_END(UPDATE_DRAWING);
      }
-     // Verifica condição de alerta baixa (LED amarelo)
-     else if (temp < TEMP_NORMAL_MAX || hum < HUMIDITY_NORMAL_MAX || bri < BRIGHTNESS_NORMAL_MAX)
+     
+     RetryMatrixFrame();
+ }
+ 
+ /**
+  * Com a fila da matriz cheia o quadro fica pendente em Leds.c; a tarefa da
+  * matriz volta a rodar até ele ser aceito, o que leva no máximo o envio de um
+  * quadro (cerca de 1 ms)
+  */
+ void RetryMatrixFrame(void)
+ {
+     if (!FlushMatrix())
+         SignalTask(matrixTask);
+ }
+ 
+ // ==================== COMANDOS DO CONSOLE ====================
+ 
+ /**
+  * Procura uma grandeza (ou "nenhum", se permitido) pelo nome usado no console
+  * @param name Nome digitado
+  * @param allowNone Aceita "nenhum" e retorna QUANTITY_COUNT
+  * @return Índice da grandeza, ou -1 se o nome não existe
+  */
+ static int FindQuantity(const char *name, bool allowNone)
+ {
+     for (int q = 0; q < QUANTITY_COUNT + allowNone; q++)
      {
-         gpio_put(RED_LED, true);
-         gpio_put(GREEN_LED, true);
-         UpdateDrawing(1);  // Padrão de alerta
-         systemState.soundAlert = false;
+         if (strcmp(name, quantityNames[q]) == 0)
+             return q;
      }
-     // Verifica condição de alerta alta (LED amarelo)
-     else if (temp > TEMP_NORMAL_MAX || hum > HUMIDITY_NORMAL_MAX || bri > BRIGHTNESS_NORMAL_MAX)
+     
+     printf("erro: grandeza desconhecida '%s'\n", name);
+     return -1;
+ }
+ 
+ void CommandGet(int argc, char **argv)
+ {
+     int q = argc == 2 ? FindQuantity(argv[1], false) : -1;
+     if (q < 0)
+         return;
+     
+     SeverityBands bands;
+     GetSeverityBands(q, &bands);
+     printf("%s: normal %d-%d, alerta ate %d, histerese %d\n", quantityNames[q],
+            bands.normalMin, bands.normalMax, bands.mediumMax, bands.hysteresis);
+ }
+ 
+ void CommandSet(int argc, char **argv)
+ {
+     int q = argc == 6 ? FindQuantity(argv[1], false) : -1;
+     if (q < 0)
+         return;
+     
+     uint8_t numbers[4];
+     for (int i = 0; i < 4; i++)
      {
-         gpio_put(RED_LED, true);
-         gpio_put(GREEN_LED, true);
-         UpdateDrawing(1);  // Padrão de alerta
-         systemState.soundAlert = false;
+         if (!ConsoleParseByte(argv[2 + i], &numbers[i]))
+         {
+             printf("erro: valor invalido '%s' (0 a 255)\n", argv[2 + i]);
+             return;
+         }
      }
-     // Condição normal (LED verde)
+     
+     SeverityBands bands = { numbers[0], numbers[1], numbers[2], numbers[3] };
+     if (!SetSeverityBands(q, &bands))
+     {
+         printf("erro: faixas incoerentes\n");
+         return;
+     }
+     CommandGet(2, argv);
+ }
+ 
+ void CommandMode(int argc, char **argv)
+ {
+     int q = argc == 2 ? FindQuantity(argv[1], true) : -1;
+     if (q < 0)
+         return;
+     
+     systemState.control = (ControlMode)q;
+     printf("controle: %s\n", quantityNames[q]);
+ }
+ 
+ void CommandState(int argc, char **argv)
+ {
+     uint8_t zone = systemState.zone;
+     uint32_t warning = 0, critical = 0;
+     
+     for (int w = 0; w < ZONE_WORDS; w++)
+     {
+         warning += __builtin_popcount(zones.warningFlags[w]);
+         critical += __builtin_popcount(zones.criticalFlags[w]);
+     }
+     
+     printf("zona %d de %d:", zone + 1, ZONE_COUNT);
+     for (int q = 0; q < QUANTITY_COUNT; q++)
+         printf(" %s %d", quantityNames[q], zones.values[q][zone]);
+     printf("\ncontrole: %s, severidade: %s, alarme: %s\n", quantityNames[systemState.control],
+            appliedSeverity < SEVERITY_COUNT ? severityNames[appliedSeverity] : "-",
+            systemState.soundAlert ? "ligado" : "desligado");
+     printf("zonas em alerta: %lu, criticas: %lu\n", (unsigned long)warning, (unsigned long)critical);
+     printf("descartes: eventos %lu, telemetria %lu\n",
+            (unsigned long)DroppedInputEvents(), (unsigned long)DroppedTelemetry());
+ }
+ 
+ void CommandStats(int argc, char **argv)
+ {
+     PrintSchedulerStats();
+ }
+ 
+ void CommandProfile(int argc, char **argv)
+ {
+ #if PROFILING
+     if (argc == 2 && strcmp(argv[1], "reset") == 0)
+         ResetProfile();
      else
+         PrintProfile();
+ #else
+     printf("perfil desativado (compile com PROFILING=ON)\n");
+ #endif
+ }
+ 
+ /**
+  * Desenha um dos padrões básicos; fica na matriz até a severidade mudar
+  */
+ void CommandPattern(int argc, char **argv)
+ {
+     uint32_t code;
+     if (argc != 2 || !ConsoleParseNumber(argv[1], &code) || code >= count_of(basePatterns))
      {
-         gpio_put(RED_LED, false);
-         gpio_put(GREEN_LED, true);
-         UpdateDrawing(0);  // Padrão normal
-         systemState.soundAlert = false;
+         printf("erro: padrao invalido\n");
+         return;
      }
-
-     printf("TEMPERATURA %d", temp);
-     printf("HUMIDADE %d", hum);
-     printf("LUMINOSIDADE %d", bri);
- }
\ No newline at end of file
+     
+     UpdateDrawing(code);
+     RetryMatrixFrame();
+ }
+ 
+ /**
+  * Desenha um símbolo de estado; fica na matriz até a severidade mudar
+  */
+ void CommandGlyph(int argc, char **argv)
+ {
+     uint32_t glyph;
+     if (argc != 2 || !ConsoleParseNumber(argv[1], &glyph) || glyph >= STATUS_GLYPH_COUNT)
+     {
+         printf("erro: simbolo invalido\n");
+         return;
+     }
+     
+     StopAnimation();
+     DrawFrame(&statusGlyphs[glyph]);
+     RetryMatrixFrame();
+ }
+ 
+ /**
+  * Troca a cor principal da matriz (antes da correção de gama) e redesenha o padrão atual
+  */
+ void CommandColor(int argc, char **argv)
+ {
+     uint8_t rgb[3];
+     for (int i = 0; i < 3; i++)
+     {
+         if (argc != 4 || !ConsoleParseByte(argv[1 + i], &rgb[i]))
+         {
+             printf("erro: cor invalida (0 a 255)\n");
+             return;
+         }
+     }
+     
+     color[0].red = rgb[0];
+     color[0].green = rgb[1];
+     color[0].blue = rgb[2];
+     Draw(drawing, color);
+     RetryMatrixFrame();
+ }
+ 
+ /**
+  * Liga ou desliga os pacotes binários de telemetria na serial; sem argumento
+  * mostra o estado atual
+  */
+ void CommandTelemetry(int argc, char **argv)
+ {
+     if (argc == 2 && strcmp(argv[1], "on") == 0)
+         EnableTelemetry(true);
+     else if (argc == 2 && strcmp(argv[1], "off") == 0)
+         EnableTelemetry(false);
+     else if (argc != 1)
+     {
+         printf("erro: use telemetry on ou telemetry off\n");
+         return;
+     }
+     
+     printf("telemetria: %s\n", TelemetryEnabled() ? "ligada" : "desligada");
+ }
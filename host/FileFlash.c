@@ -0,0 +1,141 @@
+#include <string.h>
+#include "FileFlash.h"
+
+FileFlashStats fileFlashStats;
+
+static uint8_t image[FILE_FLASH_SIZE];
+static FILE *file = NULL;
+static uint32_t failCountdown = 0;   // Operações até a falha injetada (0: nenhuma)
+static bool failWithPowerLoss = false;
+static bool powered = true;
+
+// Grava no arquivo a faixa alterada da imagem
+static void Persist(uint32_t offset, size_t len) {
+    if (!file)
+        return;
+    fseek(file, offset, SEEK_SET);
+    fwrite(image + offset, 1, len, file);
+    fflush(file);
+}
+
+/**
+ * Conta uma operação de escrita e decide se ela é a falha injetada
+ * @return Bytes da operação que chegam à flash: len, len / 2 (queda de energia
+ *         no meio) ou 0
+ */
+static size_t Admit(size_t len) {
+    if (!powered)
+        return 0;
+    if (failCountdown == 0 || --failCountdown > 0)
+        return len;
+
+    if (!failWithPowerLoss)
+        return 0;
+    powered = false;
+    return len / 2;
+}
+
+static void Read(uint32_t offset, void *data, size_t len) {
+    if (offset + len > FILE_FLASH_SIZE) {
+        fileFlashStats.misaligned++;
+        memset(data, 0xFF, len);
+        return;
+    }
+    memcpy(data, image + offset, len);
+}
+
+static bool Erase(uint32_t offset, size_t len) {
+    if (offset % FLASH_SECTOR_SIZE || len % FLASH_SECTOR_SIZE || offset + len > FILE_FLASH_SIZE) {
+        fileFlashStats.misaligned++;
+        return false;
+    }
+
+    size_t done = Admit(len);
+    memset(image + offset, 0xFF, done);
+    Persist(offset, done);
+    fileFlashStats.erases += done / FLASH_SECTOR_SIZE;
+    return done == len;
+}
+
+static bool Program(uint32_t offset, const void *data, size_t len) {
+    if (offset % FLASH_PAGE_SIZE || len % FLASH_PAGE_SIZE || offset + len > FILE_FLASH_SIZE) {
+        fileFlashStats.misaligned++;
+        return false;
+    }
+
+    size_t done = Admit(len);
+    const uint8_t *bytes = data;
+    for (size_t i = 0; i < done; i++) {
+        // 0xFF deixa o byte como está: é assim que se grava só a parte apagada de uma página
+        if (bytes[i] == 0xFF)
+            continue;
+        if (bytes[i] & ~image[offset + i])
+            fileFlashStats.violations++;
+        image[offset + i] &= bytes[i];
+        fileFlashStats.bytesProgrammed++;
+    }
+    Persist(offset, done);
+    fileFlashStats.programs += done / FLASH_PAGE_SIZE;
+    return done == len;
+}
+
+const FlashBackend fileFlash = {
+    .size = FILE_FLASH_SIZE,
+    .read = Read,
+    .erase = Erase,
+    .program = Program,
+};
+
+/**
+ * Abre a imagem da flash. Um arquivo novo, ou de outro tamanho, começa apagado
+ * @param path Arquivo da imagem, ou NULL para manter a flash só na memória
+ * @return false se o arquivo não pôde ser criado
+ */
+bool OpenFileFlash(const char *path) {
+    CloseFileFlash();
+    memset(&fileFlashStats, 0, sizeof(fileFlashStats));
+    memset(image, 0xFF, sizeof(image));
+    failCountdown = 0;
+    powered = true;
+
+    if (!path)
+        return true;
+
+    file = fopen(path, "r+b");
+    if (file && fread(image, 1, sizeof(image), file) == sizeof(image))
+        return true;
+
+    if (file)
+        fclose(file);
+    memset(image, 0xFF, sizeof(image));
+    file = fopen(path, "w+b");
+    if (!file)
+        return false;
+    Persist(0, sizeof(image));
+    return true;
+}
+
+void CloseFileFlash(void) {
+    if (file)
+        fclose(file);
+    file = NULL;
+}
+
+/**
+ * Injeta uma falha em uma operação de escrita futura
+ * @param operation Número da operação (apagamento ou gravação) a partir de agora, começando em 1
+ * @param powerLoss true: a operação fica pela metade e todas as seguintes falham
+ *                  até FileFlashPowerOn; false: só ela falha, sem alterar nada
+ */
+void FileFlashFailAt(uint32_t operation, bool powerLoss) {
+    failCountdown = operation;
+    failWithPowerLoss = powerLoss;
+}
+
+/**
+ * Volta a energia depois de uma queda injetada, como em uma reinicialização
+ */
+void FileFlashPowerOn(void) {
+    powered = true;
+    failCountdown = 0;
+}
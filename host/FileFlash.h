@@ -0,0 +1,33 @@
+#ifndef FILE_FLASH_H
+#define FILE_FLASH_H
+
+#include "FlashBackend.h"
+#include "History.h"
+
+// Região do histórico emulada com a semântica de uma flash NOR: o apagamento
+// leva um setor inteiro a 0xFF e a gravação só leva bits de 1 para 0 (bytes
+// 0xFF na gravação deixam a flash como está). O
+// conteúdo fica em um arquivo, que sobrevive entre execuções como a flash
+// sobrevive a uma reinicialização. Falhas e quedas de energia podem ser
+// injetadas em uma operação escolhida
+
+#define FILE_FLASH_SIZE HISTORY_REGION_SIZE
+
+typedef struct
+{
+    uint32_t erases;               // Setores apagados
+    uint32_t programs;             // Páginas gravadas
+    uint64_t bytesProgrammed;      // Bytes diferentes de 0xFF gravados
+    uint32_t violations;           // Gravações que precisariam levar um bit de 0 para 1
+    uint32_t misaligned;           // Operações fora do alinhamento ou da região
+} FileFlashStats;
+
+extern const FlashBackend fileFlash;
+extern FileFlashStats fileFlashStats;
+
+bool OpenFileFlash(const char *path);
+void CloseFileFlash(void);
+void FileFlashFailAt(uint32_t operation, bool powerLoss);
+void FileFlashPowerOn(void);
+
+#endif
@@ -0,0 +1,396 @@
+// A troca entre os núcleos usa _longjmp entre pilhas diferentes, o que a
+// verificação do fortify toma por erro
+#undef _FORTIFY_SOURCE
+#define _GNU_SOURCE
+
+#include <string.h>
+#include <setjmp.h>
+#include <unistd.h>
+#include <ucontext.h>
+#include "HalLinux.h"
+#include "FileFlash.h"
+#include "Sampler.h"
+#include "Pbm.h"
+
+#define CONSOLE_INPUT_SIZE 1024    // Caracteres do console ainda não lidos pelo firmware
+#define CONSOLE_OUTPUT_SIZE 1024   // Texto guardado desde a última linha digitada
+#define CORE1_STACK_SIZE (256 * 1024)
+
+SimOutputs simOutputs;
+
+// Relógio virtual e o próximo evento do roteiro
+static uint64_t nowUs = 0;
+static uint64_t eventUs = UINT64_MAX;
+static void (*eventHandler)(uint64_t nowUs);
+static bool wakePending = false;
+
+// Núcleo 1 como corrotina: roda enquanto o núcleo 0 espera em HalSleepUntil,
+// sem consumir tempo virtual, e devolve o controle quando ele mesmo dorme.
+// O contexto só cria a pilha; as trocas usam _setjmp/_longjmp, que não
+// salvam a máscara de sinais (swapcontext faz uma chamada ao sistema por troca)
+static ucontext_t core1Context;
+static jmp_buf core0Jump;
+static jmp_buf core1Jump;
+static uint8_t core1Stack[CORE1_STACK_SIZE];
+static void (*core1Entry)(void);
+static bool core1Running = false;       // O código em execução é o do núcleo 1
+static bool core1Launched = false;
+static bool core1Woken = false;         // Evento pendente para o núcleo 1 (HalWake)
+static uint64_t core1DeadlineUs = UINT64_MAX;
+
+// Temporizadores periódicos (tick NULL: livre)
+static struct
+{
+    HalTick tick;
+    uint32_t periodUs;
+    uint64_t dueUs;
+} tickers[HAL_MAX_TICKERS];
+
+// Entradas definidas pelo roteiro
+static uint16_t adcLevel[SIM_ADC_INPUTS];
+static uint32_t buttons = 0;
+static char consoleInput[CONSOLE_INPUT_SIZE];
+static uint32_t consoleHead = 0;
+static uint32_t consoleTail = 0;
+
+// Saída padrão do firmware desde a última linha digitada no console
+static char consoleOutput[CONSOLE_OUTPUT_SIZE];
+static size_t consoleOutputLength = 0;
+static FILE *realStdout = NULL;
+static bool inEventHandler = false;     // O que o roteiro escreve não entra na cópia
+
+// Configuração das saídas
+static const char *historyPath = NULL;
+static FILE *traceFile = NULL;
+static const char *frameDirectory = NULL;
+
+// Display e o último conteúdo registrado
+static const ssd1306_t *display = NULL;
+static uint8_t shownFrame[WIDTH * SSD1306_MAX_PAGES];
+
+// ==================== CONFIGURAÇÃO E ROTEIRO ====================
+
+/**
+ * @param path Arquivo da flash do histórico, ou NULL para uma flash só em memória
+ */
+void SimSetHistoryFile(const char *path) {
+    historyPath = path;
+}
+
+/**
+ * @param trace Arquivo que recebe uma linha por mudança de saída, ou NULL
+ */
+void SimSetTrace(FILE *trace) {
+    traceFile = trace;
+}
+
+/**
+ * @param directory Pasta que recebe cada conteúdo novo do display em PBM, ou NULL
+ */
+void SimSetFrameDirectory(const char *directory) {
+    frameDirectory = directory;
+}
+
+/**
+ * @param handler Chamada quando o relógio chega ao evento marcado por SimScheduleEvent
+ */
+void SimSetEventHandler(void (*handler)(uint64_t nowUs)) {
+    eventHandler = handler;
+}
+
+/**
+ * Marca o próximo evento do roteiro; o relógio para nele e chama o tratador
+ * @param timeUs Instante do evento, ou UINT64_MAX se não há mais eventos
+ */
+void SimScheduleEvent(uint64_t timeUs) {
+    eventUs = timeUs;
+}
+
+void SimSetAdc(uint8_t input, uint16_t value) {
+    if (input < SIM_ADC_INPUTS)
+        adcLevel[input] = value;
+}
+
+void SimSetButton(uint8_t gpio, bool pressed) {
+    buttons = pressed ? buttons | 1u << gpio : buttons & ~(1u << gpio);
+}
+
+/**
+ * Acrescenta uma linha à entrada do console; o que não couber é descartado
+ */
+void SimConsoleInput(const char *line) {
+    consoleOutputLength = 0;
+    consoleOutput[0] = '\0';
+    for (const char *c = line; ; c++) {
+        if (consoleTail - consoleHead == CONSOLE_INPUT_SIZE)
+            return;
+        consoleInput[consoleTail++ % CONSOLE_INPUT_SIZE] = *c ? *c : '\n';
+        if (!*c)
+            return;
+    }
+}
+
+/**
+ * @return O que o firmware escreveu na saída padrão desde a última linha de
+ *         console, limitado aos primeiros CONSOLE_OUTPUT_SIZE - 1 caracteres
+ */
+const char *SimConsoleOutput(void) {
+    return consoleOutput;
+}
+
+const ssd1306_t *SimDisplay(void) {
+    return display;
+}
+
+// Começa uma linha do rastro com o instante em segundos; false se não há rastro
+static bool TraceLine(void) {
+    if (!traceFile)
+        return false;
+    fprintf(traceFile, "%llu.%06llu", (unsigned long long)(nowUs / 1000000), (unsigned long long)(nowUs % 1000000));
+    return true;
+}
+
+// ==================== INICIALIZAÇÃO E RELÓGIO ====================
+
+// Repassa a saída padrão ao terminal e guarda uma cópia para o roteiro
+static ssize_t WriteStdout(void *cookie, const char *data, size_t len) {
+    (void)cookie;
+    if (inEventHandler)
+        return (ssize_t)fwrite(data, 1, len, realStdout);
+    size_t room = CONSOLE_OUTPUT_SIZE - 1 - consoleOutputLength;
+    size_t kept = len < room ? len : room;
+    memcpy(consoleOutput + consoleOutputLength, data, kept);
+    consoleOutputLength += kept;
+    consoleOutput[consoleOutputLength] = '\0';
+    return (ssize_t)fwrite(data, 1, len, realStdout);
+}
+
+void HalInit(void) {
+    OpenFileFlash(historyPath);
+
+    realStdout = fdopen(dup(fileno(stdout)), "w");
+    FILE *captured = realStdout ? fopencookie(NULL, "w", (cookie_io_functions_t){ .write = WriteStdout }) : NULL;
+    if (captured) {
+        setvbuf(captured, NULL, _IOLBF, 0);
+        stdout = captured;
+    }
+}
+
+// Se o laço do núcleo 1 terminar, o controle volta ao núcleo 0 de vez
+static void Core1Start(void) {
+    core1Entry();
+    core1Launched = false;
+    core1Running = false;
+    _longjmp(core0Jump, 1);
+}
+
+/**
+ * Inicia o núcleo 1 e o executa até ele dormir pela primeira vez
+ * @param entry Laço do núcleo 1
+ */
+void HalLaunchCore1(void (*entry)(void)) {
+    core1Entry = entry;
+    getcontext(&core1Context);
+    core1Context.uc_stack.ss_sp = core1Stack;
+    core1Context.uc_stack.ss_size = sizeof(core1Stack);
+    core1Context.uc_link = NULL;
+    makecontext(&core1Context, Core1Start, 0);
+
+    core1Launched = true;
+    core1Running = true;
+    if (!_setjmp(core0Jump))
+        setcontext(&core1Context);
+}
+
+// Passa a vez ao núcleo 1 se ele foi acordado ou o prazo dele venceu
+static void RunCore1(void) {
+    if (!core1Launched || core1Running || (!core1Woken && nowUs < core1DeadlineUs))
+        return;
+    core1Running = true;
+    if (!_setjmp(core0Jump))
+        _longjmp(core1Jump, 1);
+}
+
+// Espera do núcleo 1: devolve o controle ao núcleo 0 até um evento ou o prazo
+static void Core1Sleep(uint64_t deadlineUs) {
+    if (!core1Woken) {
+        core1DeadlineUs = deadlineUs;
+        core1Running = false;
+        if (!_setjmp(core1Jump))
+            _longjmp(core0Jump, 1);
+        core1DeadlineUs = UINT64_MAX;
+    }
+    core1Woken = false;
+}
+
+uint64_t HalTimeUs(void) {
+    return nowUs;
+}
+
+/**
+ * Avança o relógio virtual até o prazo, disparando no caminho os
+ * temporizadores, os eventos do roteiro e o núcleo 1. Retorna antes do prazo
+ * depois de um evento do roteiro ou de HalWake, como o WFE da placa
+ * @param deadlineUs Prazo em µs, ou UINT64_MAX para esperar só por evento
+ */
+void HalSleepUntil(uint64_t deadlineUs) {
+    if (core1Running) {
+        Core1Sleep(deadlineUs);
+        return;
+    }
+
+    RunCore1();
+    while (!wakePending) {
+        uint64_t next = deadlineUs < eventUs ? deadlineUs : eventUs;
+        if (core1Launched && core1DeadlineUs < next)
+            next = core1DeadlineUs;
+        for (int i = 0; i < HAL_MAX_TICKERS; i++) {
+            if (tickers[i].tick && tickers[i].dueUs < next)
+                next = tickers[i].dueUs;
+        }
+
+        // Nada mais pode acontecer: o tempo não tem para onde andar
+        if (next == UINT64_MAX)
+            return;
+
+        if (next > nowUs)
+            nowUs = next;
+
+        for (int i = 0; i < HAL_MAX_TICKERS; i++) {
+            if (tickers[i].tick && tickers[i].dueUs <= nowUs) {
+                tickers[i].dueUs += tickers[i].periodUs;
+                tickers[i].tick();
+            }
+        }
+
+        if (eventUs <= nowUs) {
+            eventUs = UINT64_MAX;
+            if (eventHandler) {
+                inEventHandler = true;
+                eventHandler(nowUs);
+                inEventHandler = false;
+            }
+            break;
+        }
+
+        RunCore1();
+        if (nowUs >= deadlineUs)
+            break;
+    }
+    wakePending = false;
+}
+
+// Como o SEV: acorda os dois núcleos
+void HalWake(void) {
+    wakePending = true;
+    core1Woken = true;
+}
+
+int HalStartTicker(uint32_t periodUs, HalTick tick) {
+    for (int i = 0; i < HAL_MAX_TICKERS; i++) {
+        if (tickers[i].tick)
+            continue;
+        tickers[i].tick = tick;
+        tickers[i].periodUs = periodUs;
+        tickers[i].dueUs = nowUs + periodUs;
+        return i;
+    }
+    return -1;
+}
+
+void HalStopTicker(int ticker) {
+    if (ticker >= 0 && ticker < HAL_MAX_TICKERS)
+        tickers[ticker].tick = NULL;
+}
+
+// ==================== ENTRADAS ====================
+
+uint32_t HalReadButtons(uint32_t pinMask) {
+    return buttons & pinMask;
+}
+
+/**
+ * Amostras produzidas desde a última leitura, à taxa do amostrador da placa,
+ * todas com o nível atual da entrada. O cursor guarda a contagem de amostras
+ */
+uint16_t HalAdcRead(uint8_t input, uint16_t *out, uint16_t max, uint16_t *cursor) {
+    uint16_t produced = nowUs * SAMPLER_RATE_HZ / 1000000;
+    uint16_t count = produced - *cursor;
+    if (count > max)
+        count = max;
+
+    uint16_t level = input < SIM_ADC_INPUTS ? adcLevel[input] : 0;
+    for (uint16_t i = 0; i < count; i++)
+        out[i] = level;
+
+    *cursor = produced;
+    return count;
+}
+
+int HalConsoleRead(void) {
+    if (consoleHead == consoleTail)
+        return HAL_NO_INPUT;
+    return (unsigned char)consoleInput[consoleHead++ % CONSOLE_INPUT_SIZE];
+}
+
+// ==================== SAÍDAS ====================
+
+void HalSetLed(uint8_t gpio, bool on) {
+    uint32_t leds = on ? simOutputs.leds | 1u << gpio : simOutputs.leds & ~(1u << gpio);
+    if (leds != simOutputs.leds && TraceLine())
+        fprintf(traceFile, " led %u %u\n", gpio, on);
+    simOutputs.leds = leds;
+}
+
+void HalSetBuzzer(uint16_t level) {
+    if (level != simOutputs.buzzer && TraceLine())
+        fprintf(traceFile, " buzzer %u\n", level);
+    simOutputs.buzzer = level;
+}
+
+bool HalMatrixSubmit(const uint32_t *frame) {
+    memcpy(simOutputs.matrix, frame, sizeof(simOutputs.matrix));
+    simOutputs.matrixFrames++;
+
+    // Cores no formato GRB da matriz, na ordem de envio
+    if (TraceLine()) {
+        fprintf(traceFile, " matriz");
+        for (int i = 0; i < NUM_PIXELS; i++)
+            fprintf(traceFile, " %06x", (unsigned)(frame[i] >> 8));
+        fputc('\n', traceFile);
+    }
+    return true;
+}
+
+void HalDisplayInit(ssd1306_t *ssd) {
+    ssd1306_init(ssd, WIDTH, HEIGHT, false, ADRESS, I2C_PORT);
+    display = ssd;
+    memset(shownFrame, 0, sizeof(shownFrame));
+}
+
+/**
+ * Registra o conteúdo do display quando ele muda desde o último envio
+ */
+void HalDisplaySend(ssd1306_t *ssd) {
+    if (memcmp(shownFrame, ssd->ram_buffer + 1, ssd->bufsize - 1) == 0 && simOutputs.displayFrames)
+        return;
+
+    memcpy(shownFrame, ssd->ram_buffer + 1, ssd->bufsize - 1);
+    simOutputs.displayFrames++;
+    if (TraceLine())
+        fprintf(traceFile, " display %u\n", (unsigned)simOutputs.displayFrames);
+
+    if (frameDirectory) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/display_%06u.pbm", frameDirectory, (unsigned)simOutputs.displayFrames);
+        WritePbm(path, ssd);
+    }
+}
+
+const FlashBackend *HalHistoryFlash(void) {
+    return &fileFlash;
+}
+
+void HalSerialWrite(const void *data, size_t len) {
+    simOutputs.serialBytes += len;
+}
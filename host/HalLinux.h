@@ -0,0 +1,46 @@
+#ifndef HAL_LINUX_H
+#define HAL_LINUX_H
+
+#include <stdio.h>
+#include "Hal.h"
+#include "Leds.h"
+
+// Backend de simulação da camada de hardware (HalLinux.c). O relógio é
+// virtual: HalSleepUntil salta direto para o próximo prazo, temporizador ou
+// evento do roteiro, então o firmware roda muito mais rápido que o real.
+// As entradas (ADC, botões e console) são definidas pelo roteiro, e as saídas
+// (LEDs, buzzer, matriz, display e serial) ficam registradas em simOutputs e,
+// opcionalmente, em um arquivo de rastro e em imagens PBM do display.
+// Com DUAL_CORE=1 o núcleo 1 é uma corrotina que roda sempre que o núcleo 0
+// dorme e ele foi acordado (HalWake) ou o prazo dele venceu
+
+#define SIM_ADC_INPUTS 2     // Entradas do ADC simuladas (VRY e VRX)
+
+// Saídas observadas
+typedef struct
+{
+    uint32_t leds;                     // LEDs acesos (bit n = GPIO n)
+    uint16_t buzzer;                   // Nível do PWM do buzzer
+    uint32_t matrix[NUM_PIXELS];       // Último quadro da matriz
+    uint32_t matrixFrames;             // Quadros enviados à matriz
+    uint32_t displayFrames;            // Envios que mudaram o conteúdo do display
+    uint64_t serialBytes;              // Bytes binários escritos na serial
+} SimOutputs;
+
+extern SimOutputs simOutputs;
+
+// Configuração, antes de iniciar o firmware
+void SimSetHistoryFile(const char *path);
+void SimSetTrace(FILE *trace);
+void SimSetFrameDirectory(const char *directory);
+void SimSetEventHandler(void (*handler)(uint64_t nowUs));
+
+// Roteiro
+void SimScheduleEvent(uint64_t timeUs);
+void SimSetAdc(uint8_t input, uint16_t value);
+void SimSetButton(uint8_t gpio, bool pressed);
+void SimConsoleInput(const char *line);
+const char *SimConsoleOutput(void);
+const ssd1306_t *SimDisplay(void);
+
+#endif
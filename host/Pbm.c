@@ -0,0 +1,59 @@
+#include "Pbm.h"
+
+static bool Pixel(const ssd1306_t *ssd, uint8_t x, uint8_t y) {
+    return (ssd->ram_buffer[1 + x * ssd->pages + (y >> 3)] >> (y & 7)) & 1;
+}
+
+/**
+ * Grava o framebuffer como PBM, uma linha de texto por linha de pixels
+ * @return false se o arquivo não pôde ser criado
+ */
+bool WritePbm(const char *path, const ssd1306_t *ssd) {
+    FILE *file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    fprintf(file, "P1\n%u %u\n", ssd->width, ssd->height);
+    for (uint8_t y = 0; y < ssd->height; ++y) {
+        for (uint8_t x = 0; x < ssd->width; ++x)
+            fputc(Pixel(ssd, x, y) ? '1' : '0', file);
+        fputc('\n', file);
+    }
+    return fclose(file) == 0;
+}
+
+/**
+ * Compara o framebuffer com uma imagem PBM de referência
+ * @return Quantidade de pixels diferentes, ou -1 se a imagem não pôde ser lida
+ *         ou tem outro tamanho
+ */
+long ComparePbm(const char *path, const ssd1306_t *ssd) {
+    FILE *file = fopen(path, "r");
+    if (!file)
+        return -1;
+
+    unsigned width, height;
+    if (fscanf(file, "P1 %u %u", &width, &height) != 2 || width != ssd->width || height != ssd->height) {
+        fclose(file);
+        return -1;
+    }
+
+    long diff = 0;
+    for (uint8_t y = 0; y < ssd->height; ++y) {
+        for (uint8_t x = 0; x < ssd->width; ++x) {
+            int c;
+            do
+                c = fgetc(file);
+            while (c == ' ' || c == '\n' || c == '\r' || c == '\t');
+
+            if (c != '0' && c != '1') {
+                fclose(file);
+                return -1;
+            }
+            diff += (c == '1') != Pixel(ssd, x, y);
+        }
+    }
+
+    fclose(file);
+    return diff;
+}
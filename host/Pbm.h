@@ -0,0 +1,12 @@
+#ifndef PBM_H
+#define PBM_H
+
+#include "ssd1306.h"
+
+// Imagens PBM (P1, texto) do framebuffer do display, para comparação com as
+// imagens de referência em host/golden
+
+bool WritePbm(const char *path, const ssd1306_t *ssd);
+long ComparePbm(const char *path, const ssd1306_t *ssd);
+
+#endif
@@ -0,0 +1,313 @@
+/**
+ * Executa o firmware inteiro (Irrigacao.c) sobre o backend de simulação
+ * (HalLinux.c), seguindo um roteiro de entradas e verificações. O relógio é
+ * virtual, então uma semana de operação roda em segundos
+ *
+ * Uso: Scenario --scenario roteiro.txt [--trace rastro.txt] [--frames pasta] [--flash historico.bin]
+ *
+ * Cada linha do roteiro é "<instante> <comando> [argumentos]", e # inicia um
+ * comentário. O instante é absoluto ou, com +, relativo à linha anterior, com
+ * unidade ms, s (padrão), m, h ou d: "90", "1.5s", "+10m", "2d"
+ *
+ *   adc <x|y> <valor>             nível do eixo do joystick (0 a 4095)
+ *   press <a|b|joy>               pressiona um botão
+ *   release <a|b|joy>             solta um botão
+ *   tap <a|b|joy>                 pressiona e solta 100 ms depois
+ *   console <linha>               digita uma linha no console
+ *   expect led <red|green> <on|off>
+ *   expect buzzer <on|off>
+ *   expect matrix <quadros>       pelo menos tantos quadros enviados à matriz
+ *   expect display <quadros>      pelo menos tantos conteúdos diferentes no display
+ *   expect serial <bytes>         pelo menos tantos bytes de telemetria na serial
+ *   expect history <registros>    pelo menos tantos registros no histórico
+ *   expect console <texto>        o console respondeu com o texto à última linha
+ *   end                           encerra a simulação
+ */
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "HalLinux.h"
+#include "History.h"
+#include "Bench.h"
+
+#define MAX_EVENTS 4096
+#define MAX_LINE 160
+#define TAP_US 100000
+
+typedef struct
+{
+    uint64_t timeUs;
+    uint32_t line;          // Linha do roteiro, para as mensagens
+    char text[MAX_LINE];    // Comando e argumentos
+} Event;
+
+static Event events[MAX_EVENTS];
+static uint32_t eventCount;
+static uint32_t nextEvent;
+static uint32_t failures;
+static uint64_t startNs;
+static const char *scenarioPath;
+
+int FirmwareMain(void);
+
+static bool ParseTime(const char *text, uint64_t previousUs, uint64_t *timeUs) {
+    bool relative = *text == '+';
+    char *unit;
+    double value = strtod(text + relative, &unit);
+    if (unit == text + relative || value < 0)
+        return false;
+
+    double scale;
+    if (strcmp(unit, "ms") == 0)
+        scale = 1e3;
+    else if (strcmp(unit, "") == 0 || strcmp(unit, "s") == 0)
+        scale = 1e6;
+    else if (strcmp(unit, "m") == 0)
+        scale = 60e6;
+    else if (strcmp(unit, "h") == 0)
+        scale = 3600e6;
+    else if (strcmp(unit, "d") == 0)
+        scale = 86400e6;
+    else
+        return false;
+
+    *timeUs = (relative ? previousUs : 0) + (uint64_t)(value * scale + 0.5);
+    return true;
+}
+
+static bool AddEvent(uint64_t timeUs, uint32_t line, const char *text) {
+    if (eventCount == MAX_EVENTS)
+        return false;
+    events[eventCount].timeUs = timeUs;
+    events[eventCount].line = line;
+    snprintf(events[eventCount].text, MAX_LINE, "%s", text);
+    eventCount++;
+    return true;
+}
+
+// Ordem por instante; no mesmo instante, a ordem do roteiro
+static int CompareEvents(const void *a, const void *b) {
+    const Event *x = a, *y = b;
+    if (x->timeUs != y->timeUs)
+        return x->timeUs < y->timeUs ? -1 : 1;
+    return (x->line > y->line) - (x->line < y->line);
+}
+
+static bool LoadScenario(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "%s: nao foi possivel abrir\n", path);
+        return false;
+    }
+
+    char buffer[MAX_LINE];
+    uint32_t line = 0;
+    uint64_t previousUs = 0;
+    bool ok = true;
+
+    while (ok && fgets(buffer, sizeof(buffer), file)) {
+        line++;
+        char *comment = strchr(buffer, '#');
+        if (comment)
+            *comment = '\0';
+        buffer[strcspn(buffer, "\r\n")] = '\0';
+        for (size_t n = strlen(buffer); n > 0 && strchr(" \t", buffer[n - 1]); n--)
+            buffer[n - 1] = '\0';
+
+        char *time = strtok(buffer, " \t");
+        char *command = strtok(NULL, "");
+        if (!time)
+            continue;
+
+        uint64_t timeUs;
+        if (!ParseTime(time, previousUs, &timeUs) || !command) {
+            fprintf(stderr, "%s:%u: linha invalida\n", path, line);
+            ok = false;
+            break;
+        }
+        command += strspn(command, " \t");
+        previousUs = timeUs;
+
+        // Toque: o debounce precisa ver o botão pressionado por algumas amostras
+        if (strncmp(command, "tap ", 4) == 0) {
+            char press[MAX_LINE], release[MAX_LINE];
+            snprintf(press, sizeof(press), "press %s", command + 4);
+            snprintf(release, sizeof(release), "release %s", command + 4);
+            ok = AddEvent(timeUs, line, press) && AddEvent(timeUs + TAP_US, line, release);
+        } else {
+            ok = AddEvent(timeUs, line, command);
+        }
+        if (!ok)
+            fprintf(stderr, "%s: mais de %d eventos\n", path, MAX_EVENTS);
+    }
+
+    fclose(file);
+    qsort(events, eventCount, sizeof(events[0]), CompareEvents);
+    return ok;
+}
+
+static int ButtonPin(const char *name) {
+    if (strcmp(name, "a") == 0)
+        return BUTTON_A;
+    if (strcmp(name, "b") == 0)
+        return BUTTON_B;
+    if (strcmp(name, "joy") == 0)
+        return JOYSTICK_BUTTON;
+    return -1;
+}
+
+static void CountRecord(void *context, uint32_t boot, uint32_t timeS, const uint8_t *values) {
+    (*(uint32_t *)context)++;
+}
+
+static void Finish(uint64_t nowUs) {
+    double wallS = (NowNs() - startNs) / 1e9;
+    double simS = nowUs / 1e6;
+
+    printf("cenario %s: %.1f dias simulados em %.2f s (%.0fx)\n", scenarioPath, simS / 86400, wallS, simS / wallS);
+    printf("matriz %u quadros, display %u quadros, serial %llu bytes\n", (unsigned)simOutputs.matrixFrames,
+           (unsigned)simOutputs.displayFrames, (unsigned long long)simOutputs.serialBytes);
+    printf("%s\n", failures ? "FALHOU" : "ok");
+    fflush(stdout);
+    exit(failures ? 1 : 0);
+}
+
+static void Fail(const Event *event, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    printf("%s:%u: %s: ", scenarioPath, event->line, event->text);
+    vprintf(format, args);
+    printf("\n");
+    va_end(args);
+    failures++;
+}
+
+static void Expect(const Event *event, const char *what, const char *argument) {
+    char *end;
+    unsigned long minimum = strtoul(argument, &end, 10);
+    bool number = *argument && !*end;
+
+    if (strcmp(what, "led") == 0) {
+        char name[16], state[8];
+        if (sscanf(argument, "%15s %7s", name, state) != 2) {
+            Fail(event, "argumentos invalidos");
+            return;
+        }
+        uint8_t gpio = strcmp(name, "red") == 0 ? RED_LED : GREEN_LED;
+        bool on = strcmp(state, "on") == 0;
+        bool lit = (simOutputs.leds >> gpio) & 1;
+        if (lit != on)
+            Fail(event, "esperado %d, obtido %d", on, lit);
+    } else if (strcmp(what, "buzzer") == 0) {
+        bool on = strcmp(argument, "on") == 0;
+        if ((simOutputs.buzzer > 0) != on)
+            Fail(event, "esperado %d, obtido nivel %u", on, simOutputs.buzzer);
+    } else if (strcmp(what, "matrix") == 0 && number) {
+        if (simOutputs.matrixFrames < minimum)
+            Fail(event, "esperado >= %lu, obtido %u", minimum, (unsigned)simOutputs.matrixFrames);
+    } else if (strcmp(what, "display") == 0 && number) {
+        if (simOutputs.displayFrames < minimum)
+            Fail(event, "esperado >= %lu, obtido %u", minimum, (unsigned)simOutputs.displayFrames);
+    } else if (strcmp(what, "serial") == 0 && number) {
+        if (simOutputs.serialBytes < minimum)
+            Fail(event, "esperado >= %lu, obtido %llu", minimum, (unsigned long long)simOutputs.serialBytes);
+    } else if (strcmp(what, "history") == 0 && number) {
+        uint32_t records = 0;
+        ReplayHistory(CountRecord, &records);
+        if (records < minimum)
+            Fail(event, "esperado >= %lu, obtido %u", minimum, (unsigned)records);
+    } else if (strcmp(what, "console") == 0 && *argument) {
+        if (!strstr(SimConsoleOutput(), argument))
+            Fail(event, "esperado '%s', obtido '%s'", argument, SimConsoleOutput());
+    } else {
+        Fail(event, "verificacao desconhecida");
+    }
+}
+
+static void RunEvent(const Event *event, uint64_t nowUs) {
+    char text[MAX_LINE];
+    snprintf(text, sizeof(text), "%s", event->text);
+
+    char *command = strtok(text, " \t");
+    char *argument = strtok(NULL, "");
+    if (argument)
+        argument += strspn(argument, " \t");
+    else
+        argument = "";
+
+    if (strcmp(command, "end") == 0) {
+        Finish(nowUs);
+    } else if (strcmp(command, "adc") == 0) {
+        char axis;
+        unsigned value;
+        if (sscanf(argument, "%c %u", &axis, &value) == 2 && (axis == 'x' || axis == 'y') && value < 4096)
+            SimSetAdc(axis == 'x' ? VRX_INPUT : VRY_INPUT, value);
+        else
+            Fail(event, "eixo ou valor invalido");
+    } else if (strcmp(command, "press") == 0 || strcmp(command, "release") == 0) {
+        int pin = ButtonPin(argument);
+        if (pin >= 0)
+            SimSetButton(pin, command[0] == 'p');
+        else
+            Fail(event, "botao invalido");
+    } else if (strcmp(command, "console") == 0) {
+        SimConsoleInput(argument);
+    } else if (strcmp(command, "expect") == 0) {
+        char *what = strtok(argument, " \t");
+        char *rest = strtok(NULL, "");
+        Expect(event, what ? what : "", rest ? rest : "");
+    } else {
+        Fail(event, "comando desconhecido");
+    }
+}
+
+// Aplica os eventos que venceram e marca o próximo
+static void RunDueEvents(uint64_t nowUs) {
+    while (nextEvent < eventCount && events[nextEvent].timeUs <= nowUs)
+        RunEvent(&events[nextEvent++], nowUs);
+
+    if (nextEvent < eventCount)
+        SimScheduleEvent(events[nextEvent].timeUs);
+    else
+        Finish(nowUs);
+}
+
+int main(int argc, char **argv) {
+    const char *tracePath = NULL;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--scenario") == 0)
+            scenarioPath = argv[i + 1];
+        else if (strcmp(argv[i], "--trace") == 0)
+            tracePath = argv[i + 1];
+        else if (strcmp(argv[i], "--frames") == 0)
+            SimSetFrameDirectory(argv[i + 1]);
+        else if (strcmp(argv[i], "--flash") == 0)
+            SimSetHistoryFile(argv[i + 1]);
+    }
+
+    if (!scenarioPath) {
+        fprintf(stderr, "uso: %s --scenario roteiro.txt [--trace rastro.txt] [--frames pasta] [--flash historico.bin]\n", argv[0]);
+        return 2;
+    }
+    if (!LoadScenario(scenarioPath))
+        return 2;
+
+    if (tracePath) {
+        FILE *trace = fopen(tracePath, "w");
+        if (!trace) {
+            fprintf(stderr, "%s: nao foi possivel criar\n", tracePath);
+            return 2;
+        }
+        SimSetTrace(trace);
+    }
+
+    // Entradas do instante 0 valem desde o boot
+    startNs = NowNs();
+    SimSetEventHandler(RunDueEvents);
+    RunDueEvents(0);
+
+    FirmwareMain();
+    return 1;
+}
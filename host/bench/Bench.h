@@ -0,0 +1,36 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// Medição de tempo comum aos microbenchmarks do host
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_REPEATS 5          // Rodadas de cada medição; vale a mais rápida
+
+static inline uint64_t NowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/**
+ * Mede uma função
+ * @return Menor tempo médio por iteração entre BENCH_REPEATS rodadas, em ns
+ */
+static inline double Measure(void (*run)(void *), void *context, uint32_t iterations) {
+    double best = 0;
+
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        uint64_t start = NowNs();
+        for (uint32_t i = 0; i < iterations; i++)
+            run(context);
+        double ns = (double)(NowNs() - start) / iterations;
+        if (r == 0 || ns < best)
+            best = ns;
+    }
+    return best;
+}
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * Compara o driver SSD1306 em C (ssd1306.c) com o driver em template
+ * (Ssd1306.hpp) desenhando o mesmo quadro de estado: confere que os dois
+ * framebuffers são iguais e mede o tempo por quadro. O tamanho do código de
+ * cada um é mostrado pelo alvo driver_size
+ *
+ * Uso: DriverBench [--iterations N]
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "SdkMock.h"
+#include "ssd1306.h"
+#include "Bench.h"
+
+#define DEFAULT_ITERATIONS 20000 // Iterações por rodada
+
+void DrawFrameC(ssd1306_t *ssd, uint8_t value);
+void DrawFrameCpp(uint8_t value);
+const uint8_t *FrameCppBuffer(void);
+
+static uint8_t frameValue;
+
+static void RunFrameC(void *context) {
+    DrawFrameC(context, frameValue++ % 100);
+}
+
+static void RunFrameCpp(void *context) {
+    DrawFrameCpp(frameValue++ % 100);
+}
+
+int main(int argc, char **argv) {
+    uint32_t iterations = DEFAULT_ITERATIONS;
+    int failures = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+            iterations = strtoul(argv[++i], NULL, 0);
+        else {
+            fprintf(stderr, "uso: %s [--iterations N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    MockReset();
+    ssd1306_t ssd;
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, i2c1);
+
+    for (uint8_t value = 0; value < 100; value++) {
+        DrawFrameC(&ssd, value);
+        DrawFrameCpp(value);
+        if (memcmp(ssd.ram_buffer, FrameCppBuffer(), ssd.bufsize) != 0) {
+            printf("valor %u: framebuffers diferentes entre os drivers\n", value);
+            failures++;
+            break;
+        }
+    }
+
+    if (iterations) {
+        double c = Measure(RunFrameC, &ssd, iterations);
+        double cpp = Measure(RunFrameCpp, NULL, iterations);
+        printf("%-28s %10.1f ns/quadro\n", "driver em C", c);
+        printf("%-28s %10.1f ns/quadro\n", "Ssd1306<128, 64>", cpp);
+        // O driver em C aloca o framebuffer e a cópia da GDDRAM no heap
+        printf("%-28s %10zu bytes de heap\n", "driver em C", 2 * ssd.bufsize);
+        printf("%-28s %10d bytes de heap\n", "Ssd1306<128, 64>", 0);
+    }
+
+    return failures ? 1 : 0;
+}
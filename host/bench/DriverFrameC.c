@@ -0,0 +1,26 @@
+// Quadro de estado desenhado pelo driver em C (ssd1306.c), para DriverBench
+// e para o alvo driver_size
+
+#include "ssd1306.h"
+
+// Ícone 8x8 desenhado pixel a pixel com coordenadas constantes
+static void DrawIcon(ssd1306_t *ssd) {
+    for (uint8_t i = 0; i < 8; ++i) {
+        ssd1306_pixel(ssd, 118 + i, 2 + i, true);
+        ssd1306_pixel(ssd, 125 - i, 2 + i, true);
+    }
+}
+
+void DrawFrameC(ssd1306_t *ssd, uint8_t value) {
+    char digits[] = { '0' + value / 10 % 10, '0' + value % 10, '\0' };
+
+    ssd1306_fill(ssd, false);
+    ssd1306_draw_string(ssd, "ZONA 3", 32, 0);
+    ssd1306_draw_string(ssd, "TEMPERATURA", 0, 16);
+    ssd1306_draw_string(ssd, digits, 104, 16);
+    ssd1306_draw_string(ssd, "UMIDADE      60", 0, 32);
+    ssd1306_draw_string(ssd, "LUMINOSIDADE 50", 0, 48);
+    ssd1306_rect(ssd, 58, 0, 64, 6, true, true);
+    ssd1306_vline(ssd, 100, 16, 30, true);
+    DrawIcon(ssd);
+}
@@ -0,0 +1,36 @@
+// O mesmo quadro de DriverFrameC.c desenhado pelo driver em template
+// (Ssd1306.hpp), com o framebuffer em memória estática
+
+#include "Ssd1306.hpp"
+
+static Ssd1306<WIDTH, HEIGHT> display(0x3C, i2c1);
+
+// Ícone 8x8 desenhado pixel a pixel com coordenadas constantes
+static void DrawIcon()
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        display.pixel(118 + i, 2 + i, true);
+        display.pixel(125 - i, 2 + i, true);
+    }
+}
+
+extern "C" void DrawFrameCpp(uint8_t value)
+{
+    const char digits[] = {char('0' + value / 10 % 10), char('0' + value % 10), '\0'};
+
+    display.fill(false);
+    display.draw_string("ZONA 3", 32, 0);
+    display.draw_string("TEMPERATURA", 0, 16);
+    display.draw_string(digits, 104, 16);
+    display.draw_string("UMIDADE      60", 0, 32);
+    display.draw_string("LUMINOSIDADE 50", 0, 48);
+    display.rect(58, 0, 64, 6, true, true);
+    display.vline(100, 16, 30, true);
+    DrawIcon();
+}
+
+extern "C" const uint8_t *FrameCppBuffer(void)
+{
+    return display.buffer().data();
+}
@@ -0,0 +1,187 @@
+/**
+ * Compara as rotinas de desenho do driver SSD1306 (cópia de bytes, máscaras e
+ * preenchimento por palavras) com a implementação anterior, que passava cada
+ * pixel por ssd1306_pixel. Cada caso confere primeiro que as duas produzem o
+ * mesmo framebuffer e depois mede o tempo por operação
+ *
+ * Uso: RasterBench [--iterations N]
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "SdkMock.h"
+#include "ssd1306.h"
+#include "Font.h"
+#include "Bench.h"
+
+#define DEFAULT_ITERATIONS 2000  // Iterações por rodada
+
+// Caso medido: a mesma operação desenhada pelas duas implementações
+typedef struct
+{
+    const char *name;
+    const char *unit;
+    uint32_t units;                          // Operações por chamada (ex.: glifos)
+    void (*raster)(ssd1306_t *ssd);
+    void (*reference)(ssd1306_t *ssd);
+} Case;
+
+typedef struct
+{
+    ssd1306_t *ssd;
+    void (*draw)(ssd1306_t *ssd);
+} Run;
+
+// ==================== IMPLEMENTAÇÃO PIXEL A PIXEL ====================
+
+#define REFERENCE_GLYPH(c, b0, b1, b2, b3, b4, b5, b6, b7) { b0, b1, b2, b3, b4, b5, b6, b7 },
+static const uint8_t referenceFont[FONT_GLYPH_COUNT][FONT_WIDTH] = { FONT_GLYPHS(REFERENCE_GLYPH) };
+
+static void ReferenceFill(ssd1306_t *ssd, bool value) {
+    for (uint8_t y = 0; y < ssd->height; ++y)
+        for (uint8_t x = 0; x < ssd->width; ++x)
+            ssd1306_pixel(ssd, x, y, value);
+}
+
+static void ReferenceHline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
+    for (uint8_t x = x0; x <= x1; ++x)
+        ssd1306_pixel(ssd, x, y, value);
+}
+
+static void ReferenceVline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+    for (uint8_t y = y0; y <= y1; ++y)
+        ssd1306_pixel(ssd, x, y, value);
+}
+
+static void ReferenceRect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+    for (uint8_t x = left; x < left + width; ++x) {
+        ssd1306_pixel(ssd, x, top, value);
+        ssd1306_pixel(ssd, x, top + height - 1, value);
+    }
+    for (uint8_t y = top; y < top + height; ++y) {
+        ssd1306_pixel(ssd, left, y, value);
+        ssd1306_pixel(ssd, left + width - 1, y, value);
+    }
+    if (fill)
+        for (uint8_t x = left + 1; x < left + width - 1; ++x)
+            for (uint8_t y = top + 1; y < top + height - 1; ++y)
+                ssd1306_pixel(ssd, x, y, value);
+}
+
+static void ReferenceChar(ssd1306_t *ssd, char c, uint8_t x, uint8_t y) {
+    const uint8_t *glyph = referenceFont[c - FONT_FIRST_CHAR];
+    for (uint8_t i = 0; i < 8; ++i)
+        for (uint8_t j = 0; j < 8; ++j)
+            ssd1306_pixel(ssd, x + i, y + j, (glyph[i] >> j) & 1);
+}
+
+static void ReferenceString(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y) {
+    for (; *str; str++, x += 8)
+        ReferenceChar(ssd, *str, x, y);
+}
+
+// ==================== CASOS ====================
+
+static void RasterFill(ssd1306_t *ssd) { ssd1306_fill(ssd, true); }
+static void ReferenceFillCase(ssd1306_t *ssd) { ReferenceFill(ssd, true); }
+
+static void RasterGlyphsAligned(ssd1306_t *ssd) { ssd1306_draw_string(ssd, "ABCDEFGHIJKLMNO", 0, 24); }
+static void ReferenceGlyphsAligned(ssd1306_t *ssd) { ReferenceString(ssd, "ABCDEFGHIJKLMNO", 0, 24); }
+
+static void RasterGlyphsUnaligned(ssd1306_t *ssd) { ssd1306_draw_string(ssd, "ABCDEFGHIJKLMNO", 0, 27); }
+static void ReferenceGlyphsUnaligned(ssd1306_t *ssd) { ReferenceString(ssd, "ABCDEFGHIJKLMNO", 0, 27); }
+
+static void RasterHline(ssd1306_t *ssd) { ssd1306_hline(ssd, 0, WIDTH - 1, 30, true); }
+static void ReferenceHlineCase(ssd1306_t *ssd) { ReferenceHline(ssd, 0, WIDTH - 1, 30, true); }
+
+static void RasterVline(ssd1306_t *ssd) { ssd1306_vline(ssd, 60, 0, HEIGHT - 1, true); }
+static void ReferenceVlineCase(ssd1306_t *ssd) { ReferenceVline(ssd, 60, 0, HEIGHT - 1, true); }
+
+static void RasterRectOutline(ssd1306_t *ssd) { ssd1306_rect(ssd, 3, 5, 100, 50, true, false); }
+static void ReferenceRectOutline(ssd1306_t *ssd) { ReferenceRect(ssd, 3, 5, 100, 50, true, false); }
+
+static void RasterRectFilled(ssd1306_t *ssd) { ssd1306_rect(ssd, 3, 5, 100, 50, true, true); }
+static void ReferenceRectFilled(ssd1306_t *ssd) { ReferenceRect(ssd, 3, 5, 100, 50, true, true); }
+
+// Quadro típico da tela de estado: limpa, quatro linhas de texto e a moldura
+static void RasterFrame(ssd1306_t *ssd) {
+    ssd1306_fill(ssd, false);
+    ssd1306_draw_string(ssd, "ZONA 3", 32, 0);
+    ssd1306_draw_string(ssd, "TEMPERATURA  25", 0, 16);
+    ssd1306_draw_string(ssd, "UMIDADE      60", 0, 32);
+    ssd1306_draw_string(ssd, "LUMINOSIDADE 50", 0, 48);
+    ssd1306_rect(ssd, 0, 0, WIDTH, HEIGHT, true, false);
+}
+
+static void ReferenceFrame(ssd1306_t *ssd) {
+    ReferenceFill(ssd, false);
+    ReferenceString(ssd, "ZONA 3", 32, 0);
+    ReferenceString(ssd, "TEMPERATURA  25", 0, 16);
+    ReferenceString(ssd, "UMIDADE      60", 0, 32);
+    ReferenceString(ssd, "LUMINOSIDADE 50", 0, 48);
+    ReferenceRect(ssd, 0, 0, WIDTH, HEIGHT, true, false);
+}
+
+static const Case cases[] = {
+    { "ssd1306_fill",                 "quadro", 1,  RasterFill,            ReferenceFillCase },
+    { "ssd1306_draw_char (alinhado)", "glifo",  15, RasterGlyphsAligned,   ReferenceGlyphsAligned },
+    { "ssd1306_draw_char (deslocado)", "glifo", 15, RasterGlyphsUnaligned, ReferenceGlyphsUnaligned },
+    { "ssd1306_hline (128 px)",       "linha",  1,  RasterHline,           ReferenceHlineCase },
+    { "ssd1306_vline (64 px)",        "linha",  1,  RasterVline,           ReferenceVlineCase },
+    { "ssd1306_rect (contorno)",      "ret.",   1,  RasterRectOutline,     ReferenceRectOutline },
+    { "ssd1306_rect (preenchido)",    "ret.",   1,  RasterRectFilled,      ReferenceRectFilled },
+    { "quadro da tela de estado",     "quadro", 1,  RasterFrame,           ReferenceFrame },
+};
+
+static void RunCase(void *context) {
+    Run *run = context;
+    run->draw(run->ssd);
+}
+
+static void InitDisplay(ssd1306_t *ssd) {
+    ssd1306_init(ssd, WIDTH, HEIGHT, false, 0x3C, i2c1);
+}
+
+int main(int argc, char **argv) {
+    uint32_t iterations = DEFAULT_ITERATIONS;
+    int failures = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+            iterations = strtoul(argv[++i], NULL, 0);
+        else {
+            fprintf(stderr, "uso: %s [--iterations N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    MockReset();
+    ssd1306_t raster, reference;
+    InitDisplay(&raster);
+    InitDisplay(&reference);
+
+    printf("%-30s %14s %14s %8s\n", "", "pixel a pixel", "raster", "ganho");
+    for (size_t c = 0; c < count_of(cases); c++) {
+        const Case *test = &cases[c];
+
+        memset(raster.ram_buffer + 1, 0, raster.bufsize - 1);
+        memset(reference.ram_buffer + 1, 0, reference.bufsize - 1);
+        test->raster(&raster);
+        test->reference(&reference);
+        if (memcmp(raster.ram_buffer, reference.ram_buffer, raster.bufsize) != 0) {
+            printf("%s: framebuffer diferente da implementação pixel a pixel\n", test->name);
+            failures++;
+        }
+
+        if (!iterations)
+            continue;
+        Run rasterRun = { &raster, test->raster };
+        Run referenceRun = { &reference, test->reference };
+        double referenceNs = Measure(RunCase, &referenceRun, iterations) / test->units;
+        double rasterNs = Measure(RunCase, &rasterRun, iterations) / test->units;
+        printf("%-30s %11.1f ns %11.1f ns %7.1fx  (por %s)\n",
+               test->name, referenceNs, rasterNs, referenceNs / rasterNs, test->unit);
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,293 @@
+/**
+ * Microbenchmarks do display e da matriz de LEDs, compilados para o computador
+ * contra o SDK emulado (stubs/SdkMock.c): quadros por segundo, ns por glifo e
+ * bytes no barramento por quadro. Também grava as cenas de referência em PBM e
+ * as compara com host/golden
+ *
+ * Uso: RenderBench [--iterations N] [--pbm DIR] [--golden DIR]
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "SdkMock.h"
+#include "ssd1306.h"
+#include "Font.h"
+#include "Widgets.h"
+#include "Leds.h"
+#include "MatrixDma.h"
+#include "Pbm.h"
+#include "Bench.h"
+
+#define DEFAULT_ITERATIONS 2000  // Iterações por rodada
+
+// Tela de estado, no mesmo leiaute de DrawDisplayLayout em Irrigacao.c
+typedef struct
+{
+    ssd1306_t ssd;
+    NumericField zone, temperature, humidity, brightness;
+    uint8_t values[3];
+    uint32_t frame;
+} StatusScreen;
+
+// Cena de referência: desenha no display e tem uma imagem em host/golden
+typedef struct
+{
+    const char *name;
+    void (*draw)(ssd1306_t *ssd);
+} Scene;
+
+static void Report(const char *name, double ns, const char *unit) {
+    printf("%-36s %10.1f ns/%s\n", name, ns, unit);
+}
+
+static void ReportFrame(const char *name, double ns, double bytes) {
+    printf("%-36s %10.1f ns/quadro %10.0f quadros/s %8.1f bytes/quadro\n", name, ns, 1e9 / ns, bytes);
+}
+
+// ==================== TELA DE ESTADO ====================
+
+static void InitDisplay(ssd1306_t *ssd) {
+    MockReset();
+    ssd1306_init(ssd, WIDTH, HEIGHT, false, 0x3C, i2c1);
+    ssd1306_config(ssd);
+}
+
+static void DrawStatusLayout(StatusScreen *screen) {
+    ssd1306_t *ssd = &screen->ssd;
+    ssd1306_fill(ssd, false);
+
+    DrawLabel(ssd, "ZONA", 32, 0);
+    InitNumericField(&screen->zone, 72, 0, 3, 120);
+    DrawLabel(ssd, "TEMPERATURA", 0, 16);
+    InitNumericField(&screen->temperature, 96, 16, 3, 120);
+    DrawLabel(ssd, "UMIDADE", 0, 32);
+    InitNumericField(&screen->humidity, 96, 32, 3, 120);
+    DrawLabel(ssd, "LUMINOSIDADE", 0, 48);
+    InitNumericField(&screen->brightness, 96, 48, 3, 120);
+}
+
+static void UpdateStatusFields(StatusScreen *screen) {
+    ssd1306_t *ssd = &screen->ssd;
+    UpdateNumericField(ssd, &screen->zone, 3, true);
+    UpdateNumericField(ssd, &screen->temperature, screen->values[0], true);
+    UpdateNumericField(ssd, &screen->humidity, screen->values[1], false);
+    UpdateNumericField(ssd, &screen->brightness, screen->values[2], false);
+}
+
+// Quadro completo: limpa, redesenha tudo e envia a GDDRAM inteira
+static void RunStatusRedraw(void *context) {
+    StatusScreen *screen = context;
+    DrawStatusLayout(screen);
+    UpdateStatusFields(screen);
+    ssd1306_send_data(&screen->ssd);
+}
+
+// Quadro típico: um valor muda e só o campo dele é redesenhado e enviado
+static void RunStatusUpdate(void *context) {
+    StatusScreen *screen = context;
+    screen->values[0] = 20 + (screen->frame++ & 7);
+    UpdateStatusFields(screen);
+    ssd1306_flush(&screen->ssd);
+}
+
+// O mesmo quadro típico pelo caminho do firmware: troca de buffers e envio por DMA
+static void RunStatusUpdateAsync(void *context) {
+    StatusScreen *screen = context;
+    screen->values[0] = 20 + (screen->frame++ & 7);
+    UpdateStatusFields(screen);
+    if (ssd1306_swap_buffers(&screen->ssd))
+        ssd1306_send_data_async(&screen->ssd);
+}
+
+// ==================== PRIMITIVAS ====================
+
+static void RunFill(void *context) {
+    static bool value;
+    ssd1306_fill(context, value = !value);
+}
+
+static void RunGlyphsAligned(void *context) {
+    for (uint8_t i = 0; i < 16; i++)
+        ssd1306_draw_char(context, 'A' + i, i * 8, 24);
+}
+
+static void RunGlyphsUnaligned(void *context) {
+    for (uint8_t i = 0; i < 16; i++)
+        ssd1306_draw_char(context, 'A' + i, i * 8, 27);
+}
+
+static void RunString(void *context) {
+    ssd1306_draw_string(context, "UMIDADE 60% ZN 3", 0, 40);
+}
+
+// ==================== MATRIZ ====================
+
+typedef struct
+{
+    refs pio;
+    RGB color[3];
+    uint32_t frame;
+} MatrixBench;
+
+// Alterna entre dois padrões para que o cache de Draw não descarte o quadro
+static void RunMatrixDraw(void *context) {
+    MatrixBench *bench = context;
+    Draw(Drawing(1 + (bench->frame++ & 1)), bench->color);
+    MockService();
+}
+
+// ==================== CENAS DE REFERÊNCIA ====================
+
+static void DrawStatusScene(ssd1306_t *ssd) {
+    static StatusScreen screen;
+    screen.ssd = *ssd;
+    screen.values[0] = 25;
+    screen.values[1] = 60;
+    screen.values[2] = 50;
+    DrawStatusLayout(&screen);
+    UpdateStatusFields(&screen);
+}
+
+static void DrawGlyphScene(ssd1306_t *ssd) {
+    ssd1306_fill(ssd, false);
+    for (int c = FONT_FIRST_CHAR; c <= FONT_LAST_CHAR; c++) {
+        int i = c - FONT_FIRST_CHAR;
+        ssd1306_draw_char(ssd, c, (i % 16) * 8, (i / 16) * 8);
+    }
+    ssd1306_draw_string_prop(ssd, "Prop 0123 xyz", 0, 53);
+}
+
+static void DrawShapeScene(ssd1306_t *ssd) {
+    ssd1306_fill(ssd, false);
+    ssd1306_rect(ssd, 2, 2, 40, 30, true, false);
+    ssd1306_rect(ssd, 7, 7, 30, 20, true, true);
+    ssd1306_rect(ssd, 12, 12, 20, 10, false, true);
+    ssd1306_line(ssd, 50, 2, 120, 60, true);
+    ssd1306_line(ssd, 120, 2, 50, 60, true);
+    ssd1306_hline(ssd, 0, 127, 63, true);
+    ssd1306_vline(ssd, 127, 0, 63, true);
+    ssd1306_hline(ssd, 4, 44, 45, true);
+    ssd1306_vline(ssd, 24, 36, 58, true);
+}
+
+static const Scene scenes[] = {
+    { "status", DrawStatusScene },
+    { "glyphs", DrawGlyphScene },
+    { "shapes", DrawShapeScene },
+};
+
+/**
+ * Desenha cada cena, confere que o painel emulado recebeu o mesmo conteúdo e
+ * grava ou compara a imagem
+ * @return Quantidade de cenas com diferença
+ */
+static int CheckScenes(const char *pbmDir, const char *goldenDir) {
+    int failures = 0;
+    char path[512];
+
+    for (size_t s = 0; s < count_of(scenes); s++) {
+        ssd1306_t ssd;
+        InitDisplay(&ssd);
+        scenes[s].draw(&ssd);
+        ssd1306_flush(&ssd);
+
+        if (memcmp(mockPanel.gddram, ssd.ram_buffer + 1, ssd.bufsize - 1) != 0) {
+            printf("%s: painel diferente do framebuffer depois do envio\n", scenes[s].name);
+            failures++;
+        }
+
+        if (pbmDir) {
+            snprintf(path, sizeof(path), "%s/%s.pbm", pbmDir, scenes[s].name);
+            if (!WritePbm(path, &ssd)) {
+                printf("%s: não foi possível gravar %s\n", scenes[s].name, path);
+                failures++;
+            }
+        }
+
+        if (goldenDir) {
+            snprintf(path, sizeof(path), "%s/%s.pbm", goldenDir, scenes[s].name);
+            long diff = ComparePbm(path, &ssd);
+            if (diff != 0) {
+                if (diff < 0)
+                    printf("%s: referência %s ilegível\n", scenes[s].name, path);
+                else
+                    printf("%s: %ld pixels diferentes de %s\n", scenes[s].name, diff, path);
+                failures++;
+            }
+        }
+
+        free(ssd.ram_buffer);
+        free(ssd.gddram);
+    }
+    return failures;
+}
+
+// ==================== MEDIÇÕES ====================
+
+static void RunBenchmarks(uint32_t iterations) {
+    static StatusScreen screen;
+    InitDisplay(&screen.ssd);
+    screen.values[0] = 25;
+    screen.values[1] = 60;
+    screen.values[2] = 50;
+
+    Report("ssd1306_fill", Measure(RunFill, &screen.ssd, iterations), "quadro");
+    Report("ssd1306_draw_char (y alinhado)", Measure(RunGlyphsAligned, &screen.ssd, iterations) / 16, "glifo");
+    Report("ssd1306_draw_char (y desalinhado)", Measure(RunGlyphsUnaligned, &screen.ssd, iterations) / 16, "glifo");
+    Report("ssd1306_draw_string", Measure(RunString, &screen.ssd, iterations) / 16, "glifo");
+
+    // Bytes por quadro em uma passada separada: o tráfego é determinístico
+    MockResetCounters();
+    for (uint32_t i = 0; i < 64; i++)
+        RunStatusRedraw(&screen);
+    double bytes = mockPanel.bytes / 64.0;
+    ReportFrame("tela completa + ssd1306_send_data", Measure(RunStatusRedraw, &screen, iterations), bytes);
+
+    MockResetCounters();
+    for (uint32_t i = 0; i < 64; i++)
+        RunStatusUpdate(&screen);
+    bytes = mockPanel.bytes / 64.0;
+    ReportFrame("um campo + ssd1306_flush", Measure(RunStatusUpdate, &screen, iterations), bytes);
+
+    ssd1306_init_dma(&screen.ssd);
+    MockResetCounters();
+    for (uint32_t i = 0; i < 64; i++)
+        RunStatusUpdateAsync(&screen);
+    bytes = mockPanel.bytes / 64.0;
+    ReportFrame("um campo + troca de buffers (DMA)", Measure(RunStatusUpdateAsync, &screen, iterations), bytes);
+
+    // Matriz: cada LED WS2812 recebe 24 bits
+    static MatrixBench matrix = { .pio = { pio0, 0, 0 }, .color = { { 28, 39, 53 } } };
+    SetMatrixBrightness(MATRIX_DEFAULT_BRIGHTNESS);
+    InitMatrixDMA(matrix.pio);
+    MockResetCounters();
+    for (uint32_t i = 0; i < 64; i++)
+        RunMatrixDraw(&matrix);
+    bytes = mockMatrix.words * 3 / 64.0;
+    ReportFrame("Draw (matriz, DMA)", Measure(RunMatrixDraw, &matrix, iterations), bytes);
+}
+
+int main(int argc, char **argv) {
+    uint32_t iterations = DEFAULT_ITERATIONS;
+    const char *pbmDir = NULL;
+    const char *goldenDir = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+            iterations = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "--pbm") == 0 && i + 1 < argc)
+            pbmDir = argv[++i];
+        else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc)
+            goldenDir = argv[++i];
+        else {
+            fprintf(stderr, "uso: %s [--iterations N] [--pbm DIR] [--golden DIR]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    int failures = CheckScenes(pbmDir, goldenDir);
+    if (iterations)
+        RunBenchmarks(iterations);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,158 @@
+/**
+ * Classificação das zonas em estrutura de vetores (src/Zones.c) contra a
+ * mesma classificação com uma estrutura por zona, como era o SystemState.
+ * Compilado uma vez para cada ZONE_COUNT (ZoneBench1, ZoneBench16 e
+ * ZoneBench128); confere que as duas dão os mesmos resultados e mede o tempo
+ * de uma avaliação de todas as zonas
+ *
+ * Uso: ZoneBenchN [--iterations N]  (0 só verifica, sem medir)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "Zones.h"
+#include "Bench.h"
+
+#define DEFAULT_ITERATIONS 20000
+#define CHECK_ROUNDS 2000        // Avaliações comparadas entre as duas versões
+
+// Uma zona como estrutura, com as grandezas e as severidades lado a lado
+typedef struct
+{
+    uint8_t values[QUANTITY_COUNT];
+    uint8_t severity[QUANTITY_COUNT];
+    bool warning;
+    bool critical;
+} Zone;
+
+typedef struct
+{
+    Zone zones[ZONE_COUNT];
+} ZoneArray;
+
+static uint8_t Max(uint8_t a, uint8_t b) { return a > b ? a : b; }
+static uint8_t Min(uint8_t a, uint8_t b) { return a < b ? a : b; }
+
+// Mesma tabela e mesma histerese de ClassifyBatch, zona por zona
+static Severity EvaluateZoneArray(ZoneArray *array) {
+    Severity worst = SEVERITY_NORMAL;
+
+    for (int z = 0; z < ZONE_COUNT; z++) {
+        Zone *zone = &array->zones[z];
+        uint8_t combined = SEVERITY_NORMAL;
+
+        for (int q = 0; q < QUANTITY_COUNT; q++) {
+            uint8_t entry = severityTables[q].entries[zone->values[q]];
+            uint8_t enter = entry & SEVERITY_ENTER_MASK;
+            uint8_t exit = (entry >> SEVERITY_EXIT_SHIFT) & SEVERITY_LEVEL_MASK;
+            if (zone->severity[q] & SEVERITY_LOW)
+                zone->severity[q] = entry & SEVERITY_HOLD_LOW ? SEVERITY_CRITICAL | SEVERITY_LOW : enter;
+            else
+                zone->severity[q] = Max(enter, Min(zone->severity[q], exit));
+            combined = Max(combined, zone->severity[q] & SEVERITY_LEVEL_MASK);
+        }
+
+        zone->warning = combined >= SEVERITY_WARNING;
+        zone->critical = combined == SEVERITY_CRITICAL;
+        worst = Max(worst, combined);
+    }
+    return worst;
+}
+
+// Passeio aleatório de um valor de uma zona, como uma leitura nova
+static void Step(uint32_t *seed, uint16_t *zone, uint8_t *quantity, int8_t *delta) {
+    *seed = *seed * 1664525u + 1013904223u;
+    *zone = (*seed >> 8) % ZONE_COUNT;
+    *quantity = (*seed >> 20) % QUANTITY_COUNT;
+    *delta = (int8_t)((*seed >> 24) % 21) - 10;
+}
+
+static uint8_t Clamp(int value) {
+    return value < 0 ? 0 : value > 255 ? 255 : value;
+}
+
+typedef struct
+{
+    ZoneState soa;
+    ZoneArray aos;
+    uint32_t seed;
+} Bench;
+
+static void RunSoa(void *context) {
+    Bench *bench = context;
+    uint16_t zone; uint8_t q; int8_t delta;
+    Step(&bench->seed, &zone, &q, &delta);
+    bench->soa.values[q][zone] = Clamp(bench->soa.values[q][zone] + delta);
+    EvaluateZones(&bench->soa);
+}
+
+static void RunAos(void *context) {
+    Bench *bench = context;
+    uint16_t zone; uint8_t q; int8_t delta;
+    Step(&bench->seed, &zone, &q, &delta);
+    bench->aos.zones[zone].values[q] = Clamp(bench->aos.zones[zone].values[q] + delta);
+    EvaluateZoneArray(&bench->aos);
+}
+
+static void InitBench(Bench *bench) {
+    static const uint8_t defaults[QUANTITY_COUNT] = { 25, 60, 50 };
+    InitZones(&bench->soa, defaults);
+    for (int z = 0; z < ZONE_COUNT; z++) {
+        for (int q = 0; q < QUANTITY_COUNT; q++) {
+            bench->aos.zones[z].values[q] = defaults[q];
+            bench->aos.zones[z].severity[q] = SEVERITY_NORMAL;
+        }
+    }
+    bench->seed = 1;
+}
+
+// As duas versões recebem as mesmas leituras e têm de concordar em tudo
+static int Compare(Bench *bench) {
+    uint32_t seed = 1;
+
+    for (int round = 0; round < CHECK_ROUNDS; round++) {
+        uint16_t zone; uint8_t q; int8_t delta;
+        Step(&seed, &zone, &q, &delta);
+        // Passos grandes para passar por todas as faixas
+        uint8_t value = Clamp(bench->soa.values[q][zone] + delta * 4);
+        bench->soa.values[q][zone] = value;
+        bench->aos.zones[zone].values[q] = value;
+
+        if (EvaluateZones(&bench->soa) != EvaluateZoneArray(&bench->aos)) {
+            printf("rodada %d: severidade geral diferente\n", round);
+            return 1;
+        }
+        for (int z = 0; z < ZONE_COUNT; z++) {
+            const Zone *expected = &bench->aos.zones[z];
+            bool same = ZoneFlag(bench->soa.warningFlags, z) == expected->warning &&
+                        ZoneFlag(bench->soa.criticalFlags, z) == expected->critical;
+            for (int k = 0; k < QUANTITY_COUNT; k++)
+                same = same && bench->soa.severity[k][z] == expected->severity[k];
+            if (!same) {
+                printf("rodada %d: zona %d diferente\n", round, z);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    static Bench bench;
+    uint32_t iterations = DEFAULT_ITERATIONS;
+    if (argc == 3 && strcmp(argv[1], "--iterations") == 0)
+        iterations = strtoul(argv[2], NULL, 0);
+
+    InitBench(&bench);
+    int failures = Compare(&bench);
+
+    if (iterations) {
+        InitBench(&bench);
+        double aos = Measure(RunAos, &bench, iterations);
+        InitBench(&bench);
+        double soa = Measure(RunSoa, &bench, iterations);
+        printf("%3d zonas: estrutura por zona %9.1f ns  vetores %9.1f ns  (%.2f ns/zona)\n",
+               ZONE_COUNT, aos, soa, soa / ZONE_COUNT);
+    }
+    return failures;
+}
@@ -0,0 +1,403 @@
+#include <string.h>
+#include "SdkMock.h"
+#include "hardware/dma.h"
+#include "hardware/i2c.h"
+#include "hardware/pio.h"
+#include "hardware/adc.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "hardware/flash.h"
+#include "hardware/timer.h"
+#include "pico/flash.h"
+#include "pio_matrix.pio.h"
+
+MockPanel mockPanel;
+MockMatrix mockMatrix;
+uint64_t mockTimeUs = 0;
+bool mockAlarmMissed = false;
+
+const absolute_time_t nil_time = 0;
+const absolute_time_t at_the_end_of_time = UINT64_MAX;
+
+static i2c_hw_t i2cHw[2] = { { .status = I2C_IC_STATUS_TFE_BITS }, { .status = I2C_IC_STATUS_TFE_BITS } };
+i2c_inst_t i2c0_inst = { &i2cHw[0] };
+i2c_inst_t i2c1_inst = { &i2cHw[1] };
+pio_hw_t pio0_hw;
+
+// ==================== PAINEL SSD1306 ====================
+
+// Estado do controlador: janela de escrita, ponteiro e comando em andamento
+static struct
+{
+    uint8_t mode;                // 0 horizontal, 1 vertical
+    uint8_t col0, col1, page0, page1;
+    uint8_t col, page;
+    uint8_t command;             // Comando aguardando argumentos
+    uint8_t args[2];
+    uint8_t argCount, argNeeded;
+} panel;
+
+static uint8_t ArgumentCount(uint8_t command) {
+    switch (command) {
+    case 0x21: case 0x22:
+        return 2;
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static void PanelCommand(uint8_t byte) {
+    if (panel.argNeeded) {
+        panel.args[panel.argCount++] = byte;
+        if (panel.argCount < panel.argNeeded)
+            return;
+        panel.argNeeded = 0;
+    } else {
+        panel.command = byte;
+        panel.argCount = 0;
+        panel.argNeeded = ArgumentCount(byte);
+        if (panel.argNeeded)
+            return;
+    }
+
+    switch (panel.command) {
+    case 0x20:
+        panel.mode = panel.args[0];
+        break;
+    case 0x21:
+        panel.col0 = panel.col = panel.args[0] % MOCK_PANEL_WIDTH;
+        panel.col1 = panel.args[1] % MOCK_PANEL_WIDTH;
+        break;
+    case 0x22:
+        panel.page0 = panel.page = panel.args[0] % MOCK_PANEL_PAGES;
+        panel.page1 = panel.args[1] % MOCK_PANEL_PAGES;
+        break;
+    }
+}
+
+static void PanelData(uint8_t byte) {
+    mockPanel.gddram[panel.col * MOCK_PANEL_PAGES + panel.page] = byte;
+    mockPanel.dataBytes++;
+
+    if (panel.mode == 1) {
+        if (panel.page++ == panel.page1) {
+            panel.page = panel.page0;
+            panel.col = panel.col == panel.col1 ? panel.col0 : panel.col + 1;
+        }
+    } else {
+        if (panel.col++ == panel.col1) {
+            panel.col = panel.col0;
+            panel.page = panel.page == panel.page1 ? panel.page0 : panel.page + 1;
+        }
+    }
+}
+
+// Uma transação: bytes de controle com Co = 1 valem para um byte; com Co = 0
+// valem para o resto da transação. D/C# separa comandos de dados
+static void PanelTransaction(const uint8_t *bytes, size_t len) {
+    mockPanel.transactions++;
+    mockPanel.bytes += len;
+
+    size_t i = 0;
+    while (i < len) {
+        uint8_t control = bytes[i++];
+        bool data = control & 0x40;
+        bool single = control & 0x80;
+
+        for (; i < len; i++) {
+            if (data)
+                PanelData(bytes[i]);
+            else
+                PanelCommand(bytes[i]);
+            if (single) {
+                i++;
+                break;
+            }
+        }
+    }
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    PanelTransaction(src, len);
+    return (int)len;
+}
+
+uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx) {
+    return 0;
+}
+
+// ==================== DMA E PIO ====================
+
+static struct
+{
+    bool claimed;
+    dma_channel_config config;
+    volatile void *write;
+    bool irqEnabled;
+    bool irqPending;
+} channels[NUM_DMA_CHANNELS];
+
+static irq_handler_t dmaHandler;
+
+int dma_claim_unused_channel(bool required) {
+    for (int i = 0; i < NUM_DMA_CHANNELS; i++) {
+        if (!channels[i].claimed) {
+            channels[i].claimed = true;
+            return i;
+        }
+    }
+    return -1;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    dma_channel_config c = { DMA_SIZE_32, true, false };
+    return c;
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) { c->size = size; }
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) { c->read_increment = incr; }
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) { c->write_increment = incr; }
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {}
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits) {}
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) {}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    channels[channel].config = *config;
+    channels[channel].write = write_addr;
+}
+
+// Executa a transferência inteira de uma vez, conforme o destino
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count) {
+    volatile void *write = channels[channel].write;
+
+    for (int i = 0; i < 2; i++) {
+        if (write != &i2cHw[i].data_cmd)
+            continue;
+
+        // Palavras do IC_DATA_CMD: o byte baixo é o dado, o resto são flags
+        const volatile uint16_t *words = read_addr;
+        uint8_t bytes[2048];
+        size_t len = transfer_count < sizeof(bytes) ? transfer_count : sizeof(bytes);
+        for (size_t k = 0; k < len; k++)
+            bytes[k] = words[k] & 0xFF;
+        PanelTransaction(bytes, len);
+    }
+
+    for (int sm = 0; sm < 4; sm++) {
+        if (write != &pio0_hw.txf[sm])
+            continue;
+
+        const volatile uint32_t *words = read_addr;
+        mockMatrix.lastCount = transfer_count < MOCK_MATRIX_WORDS ? transfer_count : MOCK_MATRIX_WORDS;
+        for (uint32_t k = 0; k < mockMatrix.lastCount; k++)
+            mockMatrix.last[k] = words[k];
+        mockMatrix.words += transfer_count;
+        mockMatrix.frames++;
+    }
+
+    if (channels[channel].irqEnabled)
+        channels[channel].irqPending = true;
+}
+
+void dma_channel_start(uint channel) {}
+bool dma_channel_is_busy(uint channel) { return false; }
+void dma_channel_set_irq0_enabled(uint channel, bool enabled) { channels[channel].irqEnabled = enabled; }
+bool dma_channel_get_irq0_status(uint channel) { return channels[channel].irqPending; }
+void dma_channel_acknowledge_irq0(uint channel) { channels[channel].irqPending = false; }
+
+void irq_set_enabled(uint num, bool enabled) {}
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    if (num == DMA_IRQ_0)
+        dmaHandler = handler;
+}
+
+uint32_t save_and_disable_interrupts(void) { return 0; }
+void restore_interrupts(uint32_t status) {}
+
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx) { return 0; }
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+    if (mockMatrix.lastCount == MOCK_MATRIX_WORDS)
+        mockMatrix.lastCount = 0;
+    mockMatrix.last[mockMatrix.lastCount++] = data;
+    mockMatrix.words++;
+}
+
+// Programa da matriz: o PIO emulado não executa instruções
+const pio_program_t pio_matrix_program = { 0 };
+
+uint pio_add_program(PIO pio, const pio_program_t *program) { return 0; }
+int pio_claim_unused_sm(PIO pio, bool required) { return 0; }
+
+// Como src/pio_matrix.pio: todo o FIFO para a transmissão
+void pio_matrix_program_init(PIO pio, uint sm, uint offset, uint pin) {
+    pio->sm[sm].shiftctrl |= PIO_SM0_SHIFTCTRL_FJOIN_TX_BITS;
+}
+
+// ==================== DEMAIS PERIFÉRICOS ====================
+
+// Registradores lidos pelo amostrador do ADC; sem DMA ativo o anel fica parado
+static dma_hw_t dmaHw;
+static adc_hw_t adcHw;
+dma_hw_t *dma_hw = &dmaHw;
+adc_hw_t *adc_hw = &adcHw;
+
+void adc_init(void) {}
+void adc_gpio_init(uint gpio) {}
+void adc_select_input(uint input) {}
+void adc_set_round_robin(uint input_mask) {}
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {}
+void adc_set_clkdiv(float clkdiv) {}
+void adc_run(bool run) {}
+void adc_fifo_drain(void) {}
+
+// GPIO: saídas registradas em mockGpioOut; as entradas (pull-up) leem nível alto
+uint32_t mockGpioOut = 0;
+
+void gpio_init(uint gpio) {}
+void gpio_set_dir(uint gpio, bool out) {}
+void gpio_pull_up(uint gpio) {}
+void gpio_set_function(uint gpio, int function) {}
+void gpio_put(uint gpio, bool value) { mockGpioOut = value ? mockGpioOut | 1u << gpio : mockGpioOut & ~(1u << gpio); }
+uint32_t gpio_get_all(void) { return ~0u; }
+
+uint pwm_gpio_to_slice_num(uint gpio) { return (gpio >> 1) & 7; }
+void pwm_set_wrap(uint slice_num, uint16_t wrap) {}
+void pwm_set_enabled(uint slice_num, bool enabled) {}
+void pwm_set_gpio_level(uint gpio, uint16_t level) {}
+
+bool stdio_init_all(void) { return true; }
+bool set_sys_clock_khz(uint32_t freq_khz, bool required) { return true; }
+uint32_t clock_get_hz(enum clock_index clk_index) { return 125000000; }
+int getchar_timeout_us(uint32_t timeout_us) { return PICO_ERROR_TIMEOUT; }
+void stdio_put_string(const char *s, int len, bool newline, bool cr_translation) { fwrite(s, 1, len, stdout); }
+
+// Flash da placa: sem efeito, o histórico é testado sobre host/FileFlash.c
+void flash_range_erase(uint32_t flash_offs, size_t count) {}
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {}
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms) {
+    func(param);
+    return PICO_OK;
+}
+
+// ==================== TEMPO E ALARMES ====================
+
+static struct
+{
+    bool claimed;
+    bool armed;
+    hardware_alarm_callback_t callback;
+    uint64_t due;
+} alarms[NUM_TIMERS];
+
+uint64_t time_us_64(void) { return mockTimeUs; }
+absolute_time_t from_us_since_boot(uint64_t us) { return us; }
+absolute_time_t make_timeout_time_us(uint64_t us) { return mockTimeUs + us; }
+
+// Espera do escalonador: o relógio salta até o prazo
+bool best_effort_wfe_or_timeout(absolute_time_t t) {
+    if (t != at_the_end_of_time && t > mockTimeUs)
+        mockTimeUs = t;
+    return true;
+}
+uint32_t time_us_32(void) { return (uint32_t)mockTimeUs; }
+
+void busy_wait_us_32(uint32_t us) { mockTimeUs += us; }
+
+int hardware_alarm_claim_unused(bool required) {
+    for (int i = 0; i < NUM_TIMERS; i++) {
+        if (!alarms[i].claimed) {
+            alarms[i].claimed = true;
+            return i;
+        }
+    }
+    return -1;
+}
+
+void hardware_alarm_set_callback(uint alarm_num, hardware_alarm_callback_t callback) {
+    alarms[alarm_num].callback = callback;
+}
+
+// Arma o alarme para MockService; com mockAlarmMissed informa o prazo como já passado
+bool hardware_alarm_set_target(uint alarm_num, absolute_time_t t) {
+    if (mockAlarmMissed) {
+        mockAlarmMissed = false;
+        return true;
+    }
+    alarms[alarm_num].armed = true;
+    alarms[alarm_num].due = t;
+    return false;
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out) {
+    return add_repeating_timer_us((int64_t)delay_ms * 1000, callback, user_data, out);
+}
+
+// Temporizadores periódicos não são executados pelos alvos do host
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out) {
+    out->delay_us = delay_us;
+    out->callback = callback;
+    out->user_data = user_data;
+    return true;
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer) {
+    timer->callback = NULL;
+    return true;
+}
+
+/**
+ * Entrega as interrupções de DMA pendentes e dispara os alarmes, avançando o
+ * relógio até cada um, até não restar nada pendente
+ */
+void MockService(void) {
+    bool progress = true;
+
+    while (progress) {
+        progress = false;
+
+        for (int c = 0; c < NUM_DMA_CHANNELS; c++) {
+            if (channels[c].irqPending && dmaHandler) {
+                dmaHandler();
+                progress = true;
+            }
+        }
+
+        for (int i = 0; i < NUM_TIMERS; i++) {
+            if (!alarms[i].armed)
+                continue;
+
+            alarms[i].armed = false;
+            if (alarms[i].due > mockTimeUs)
+                mockTimeUs = alarms[i].due;
+            alarms[i].callback(i);
+            progress = true;
+        }
+    }
+}
+
+// Zera os contadores de tráfego, mantendo o conteúdo do painel
+void MockResetCounters(void) {
+    mockPanel.transactions = 0;
+    mockPanel.bytes = 0;
+    mockPanel.dataBytes = 0;
+    mockMatrix.frames = 0;
+    mockMatrix.words = 0;
+}
+
+// Painel apagado e controlador no estado de reset
+void MockReset(void) {
+    memset(&mockPanel, 0, sizeof(mockPanel));
+    memset(&panel, 0, sizeof(panel));
+    panel.col1 = MOCK_PANEL_WIDTH - 1;
+    panel.page1 = MOCK_PANEL_PAGES - 1;
+    MockResetCounters();
+}
@@ -0,0 +1,57 @@
+#ifndef SDK_MOCK_H
+#define SDK_MOCK_H
+
+// Periféricos emulados pelos alvos do host (SdkMock.c)
+//
+// I2C: cada transação é contada e interpretada como o SSD1306 faria (bytes de
+// controle, comandos de janela e dados no modo de endereçamento vertical), de
+// modo que o conteúdo do painel pode ser comparado com o framebuffer.
+// DMA: as transferências acontecem na hora. Para o I2C viram uma transação;
+// para o FIFO do PIO viram um quadro da matriz. A interrupção de fim fica
+// pendente até MockService().
+// Alarmes de hardware: disparam em MockService(), que avança o relógio até
+// cada um; mockAlarmMissed simula uma interrupção que chega depois do prazo.
+
+#include "pico/stdlib.h"
+
+#define MOCK_PANEL_WIDTH 128
+#define MOCK_PANEL_PAGES 8
+#define MOCK_MATRIX_WORDS 32     // Maior quadro capturado da matriz
+
+// Painel SSD1306 reconstruído a partir do tráfego I2C
+typedef struct
+{
+    uint32_t transactions;       // Transações I2C (cada uma custa início, endereço e parada)
+    uint32_t bytes;              // Bytes após o endereço (controle, comandos e dados)
+    uint32_t dataBytes;          // Bytes escritos na GDDRAM
+    uint8_t gddram[MOCK_PANEL_WIDTH * MOCK_PANEL_PAGES];   // Mesmo leiaute do ram_buffer (coluna * páginas + página)
+} MockPanel;
+
+// Quadros enviados à matriz, por DMA ou por pio_sm_put_blocking
+typedef struct
+{
+    uint32_t frames;             // Quadros completos enviados por DMA
+    uint32_t words;              // Palavras enviadas ao FIFO do PIO
+    uint32_t last[MOCK_MATRIX_WORDS];
+    uint32_t lastCount;
+} MockMatrix;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern MockPanel mockPanel;
+extern MockMatrix mockMatrix;
+extern uint64_t mockTimeUs;
+extern bool mockAlarmMissed;         // O próximo hardware_alarm_set_target informa prazo já passado
+extern uint32_t mockGpioOut;         // Nível das saídas de gpio_put (bit n = GPIO n)
+
+void MockReset(void);
+void MockResetCounters(void);
+void MockService(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef HARDWARE_CLOCKS_H
+#define HARDWARE_CLOCKS_H
+
+#include "pico/stdlib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum clock_index { clk_sys = 5 };
+uint32_t clock_get_hz(enum clock_index clk_index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
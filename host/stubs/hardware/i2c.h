@@ -0,0 +1,45 @@
+#ifndef HARDWARE_I2C_H
+#define HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define I2C_IC_DATA_CMD_STOP_BITS 0x200u
+#define I2C_IC_STATUS_MST_ACTIVITY_BITS 0x20u
+#define I2C_IC_STATUS_TFE_BITS 0x4u
+
+typedef struct
+{
+    volatile uint32_t enable;
+    volatile uint32_t tar;
+    volatile uint32_t data_cmd;
+    volatile uint32_t status;
+} i2c_hw_t;
+
+typedef struct i2c_inst
+{
+    i2c_hw_t *hw;
+} i2c_inst_t;
+
+extern i2c_inst_t i2c0_inst;
+extern i2c_inst_t i2c1_inst;
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx);
+
+static inline i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c)
+{
+    return i2c->hw;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef HARDWARE_IRQ_H
+#define HARDWARE_IRQ_H
+
+#include "pico/stdlib.h"
+
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef HARDWARE_PIO_H
+#define HARDWARE_PIO_H
+
+#include "pico/stdlib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PIO_SM0_SHIFTCTRL_FJOIN_TX_BITS 0x40000000u
+
+// Só os registradores lidos pelo firmware
+typedef struct
+{
+    volatile uint32_t shiftctrl;
+} pio_sm_hw_t;
+
+typedef struct
+{
+    volatile uint32_t txf[4];
+    pio_sm_hw_t sm[4];
+} pio_hw_t;
+typedef pio_hw_t *PIO;
+
+extern pio_hw_t pio0_hw;
+#define pio0 (&pio0_hw)
+
+typedef struct
+{
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+} pio_program_t;
+
+uint pio_add_program(PIO pio, const pio_program_t *program);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
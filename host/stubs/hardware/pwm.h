@@ -0,0 +1,19 @@
+#ifndef HARDWARE_PWM_H
+#define HARDWARE_PWM_H
+
+#include "pico/stdlib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint pwm_gpio_to_slice_num(uint gpio);
+void pwm_set_wrap(uint slice_num, uint16_t wrap);
+void pwm_set_enabled(uint slice_num, bool enabled);
+void pwm_set_gpio_level(uint gpio, uint16_t level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
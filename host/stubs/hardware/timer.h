@@ -0,0 +1,22 @@
+#ifndef HARDWARE_TIMER_H
+#define HARDWARE_TIMER_H
+
+#include "pico/stdlib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NUM_TIMERS 4
+
+// Alarmes de hardware: um por uso, sem a fila de alarmes do SDK
+typedef void (*hardware_alarm_callback_t)(uint alarm_num);
+int hardware_alarm_claim_unused(bool required);
+void hardware_alarm_set_callback(uint alarm_num, hardware_alarm_callback_t callback);
+bool hardware_alarm_set_target(uint alarm_num, absolute_time_t t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
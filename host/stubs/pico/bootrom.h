@@ -0,0 +1,6 @@
+#ifndef PICO_BOOTROM_H
+#define PICO_BOOTROM_H
+
+#include "pico/stdlib.h"
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef PICO_FLASH_H
+#define PICO_FLASH_H
+
+#include "pico/stdlib.h"
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms);
+bool flash_safe_execute_core_init(void);
+
+#endif
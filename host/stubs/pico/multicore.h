@@ -0,0 +1,9 @@
+#ifndef PICO_MULTICORE_H
+#define PICO_MULTICORE_H
+
+#include "pico/stdlib.h"
+
+void multicore_launch_core1(void (*entry)(void));
+bool multicore_lockout_victim_is_initialized(uint core_num);
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef PICO_STDLIB_H
+#define PICO_STDLIB_H
+
+// Subconjunto do Pico SDK usado pelo firmware, para compilar os módulos no
+// computador. Só declarações: as funções usadas pelos alvos do host estão em
+// SdkMock.c, que emula o barramento I2C, o DMA e o PIO
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef unsigned int uint;
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#define __not_in_flash_func(f) f
+#define __time_critical_func(f) f
+
+#define PICO_OK 0
+#define PICO_ERROR_TIMEOUT -1
+#define PICO_ERROR_GENERIC -2
+#define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024)
+#define XIP_BASE 0x10000000
+
+// Tempo
+typedef uint64_t absolute_time_t;
+extern const absolute_time_t nil_time;
+extern const absolute_time_t at_the_end_of_time;
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+absolute_time_t get_absolute_time(void);
+absolute_time_t from_us_since_boot(uint64_t us);
+absolute_time_t make_timeout_time_ms(uint32_t ms);
+absolute_time_t make_timeout_time_us(uint64_t us);
+bool time_reached(absolute_time_t t);
+bool best_effort_wfe_or_timeout(absolute_time_t t);
+void sleep_ms(uint32_t ms);
+void sleep_us(uint64_t us);
+void busy_wait_us_32(uint32_t us);
+
+// Temporizadores
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+struct repeating_timer
+{
+    int64_t delay_us;
+    repeating_timer_callback_t callback;
+    void *user_data;
+};
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out);
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out);
+bool cancel_repeating_timer(repeating_timer_t *timer);
+
+// GPIO
+#define GPIO_FUNC_I2C 3
+#define GPIO_FUNC_PWM 4
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_pull_up(uint gpio);
+void gpio_put(uint gpio, bool value);
+bool gpio_get(uint gpio);
+uint32_t gpio_get_all(void);
+void gpio_set_function(uint gpio, int function);
+
+// Interrupções e sincronização entre núcleos
+#define DMA_IRQ_0 11
+#define DMA_IRQ_1 12
+typedef void (*irq_handler_t)(void);
+void irq_set_enabled(uint num, bool enabled);
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority);
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+static inline void __dmb(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __sev(void) {}
+static inline void __wfe(void) {}
+static inline void tight_loop_contents(void) {}
+
+// stdio
+bool stdio_init_all(void);
+int getchar_timeout_us(uint32_t timeout_us);
+void stdio_put_string(const char *s, int len, bool newline, bool cr_translation);
+
+// Relógios
+bool set_sys_clock_khz(uint32_t freq_khz, bool required);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef PIO_MATRIX_PIO_H
+#define PIO_MATRIX_PIO_H
+
+// Substitui o cabeçalho gerado pelo pioasm a partir de src/pio_matrix.pio
+
+#include "hardware/pio.h"
+
+extern const pio_program_t pio_matrix_program;
+void pio_matrix_program_init(PIO pio, uint sm, uint offset, uint pin);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+// Verificação mínima dos testes do host: registra a falha e segue adiante,
+// para que um único executável relate todos os casos quebrados de uma vez
+
+#include <stdio.h>
+
+static int checkFailures;
+
+#define CHECK(condition)                                                       \
+    do {                                                                       \
+        if (!(condition)) {                                                    \
+            printf("%s:%d: falhou: %s\n", __FILE__, __LINE__, #condition);     \
+            checkFailures++;                                                   \
+        }                                                                      \
+    } while (0)
+
+// Código de saída do teste: 0 se nenhuma verificação falhou
+#define CHECK_RESULT() (checkFailures ? 1 : 0)
+
+#endif
@@ -0,0 +1,74 @@
+/**
+ * Classificação por tabela (src/Classifier.cpp): histerese em cada lado da
+ * faixa normal e validação das faixas trocadas em execução
+ */
+
+#include "Classifier.h"
+#include "Check.h"
+
+// Classifica um valor de umidade (normal 40-60, alerta até 80, histerese 2)
+// em uma zona e devolve a severidade combinada
+static uint8_t Classify(uint8_t value, uint8_t *memory) {
+    uint8_t combined = SEVERITY_NORMAL;
+    ClassifyBatch(QUANTITY_HUMIDITY, &value, memory, &combined, 1);
+    return combined;
+}
+
+static void TestHighSide(void) {
+    uint8_t memory = SEVERITY_NORMAL;
+
+    CHECK(Classify(60, &memory) == SEVERITY_NORMAL);
+    CHECK(Classify(61, &memory) == SEVERITY_WARNING);
+    CHECK(Classify(59, &memory) == SEVERITY_WARNING);     // Ainda na histerese
+    CHECK(Classify(58, &memory) == SEVERITY_NORMAL);
+    CHECK(Classify(81, &memory) == SEVERITY_CRITICAL);
+    CHECK(Classify(79, &memory) == SEVERITY_CRITICAL);
+    CHECK(Classify(78, &memory) == SEVERITY_WARNING);
+}
+
+static void TestLowSide(void) {
+    uint8_t memory = SEVERITY_NORMAL;
+
+    CHECK(Classify(39, &memory) == SEVERITY_CRITICAL);
+    CHECK(Classify(41, &memory) == SEVERITY_CRITICAL);    // Ainda na histerese
+    CHECK(Classify(42, &memory) == SEVERITY_NORMAL);
+
+    // Do crítico por baixo direto para perto do máximo: a histerese do lado de
+    // cima não vale, então é normal (antes virava alerta)
+    CHECK(Classify(30, &memory) == SEVERITY_CRITICAL);
+    CHECK(Classify(59, &memory) == SEVERITY_NORMAL);
+
+    CHECK(Classify(30, &memory) == SEVERITY_CRITICAL);
+    CHECK(Classify(61, &memory) == SEVERITY_WARNING);
+
+    // Do crítico por cima para baixo do mínimo e de volta
+    CHECK(Classify(90, &memory) == SEVERITY_CRITICAL);
+    CHECK(Classify(35, &memory) == SEVERITY_CRITICAL);
+    CHECK(Classify(41, &memory) == SEVERITY_CRITICAL);
+    CHECK(Classify(50, &memory) == SEVERITY_NORMAL);
+}
+
+static void TestSetBands(void) {
+    SeverityBands original, bands;
+    GetSeverityBands(QUANTITY_HUMIDITY, &original);
+
+    bands = (SeverityBands){ 40, 60, 60, 2 };
+    CHECK(!SetSeverityBands(QUANTITY_HUMIDITY, &bands));
+    bands = (SeverityBands){ 40, 43, 80, 2 };
+    CHECK(!SetSeverityBands(QUANTITY_HUMIDITY, &bands));
+
+    bands = (SeverityBands){ 0, 200, 255, 5 };
+    CHECK(SetSeverityBands(QUANTITY_HUMIDITY, &bands));
+    uint8_t memory = SEVERITY_NORMAL;
+    CHECK(Classify(0, &memory) == SEVERITY_NORMAL);
+    CHECK(Classify(255, &memory) == SEVERITY_WARNING);
+
+    CHECK(SetSeverityBands(QUANTITY_HUMIDITY, &original));
+}
+
+int main(void) {
+    TestHighSide();
+    TestLowSide();
+    TestSetBands();
+    return CHECK_RESULT();
+}
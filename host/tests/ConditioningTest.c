@@ -0,0 +1,144 @@
+/**
+ * Estágios de condicionamento do joystick (src/Conditioning.c): resposta de
+ * cada estágio a degraus e picos, independência do tamanho do bloco e custo
+ * por amostra de cada estágio e do pipeline do eixo X
+ *
+ * Uso: ConditioningTest [--iterations N]  (0 só verifica, sem medir)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "Conditioning.h"
+#include "Bench.h"
+#include "Check.h"
+
+#define BLOCK 64                 // Amostras de um eixo no anel do ADC
+#define DEFAULT_ITERATIONS 20000
+
+static void Fill(int32_t *samples, uint16_t count, int32_t value) {
+    for (uint16_t i = 0; i < count; i++)
+        samples[i] = value;
+}
+
+static void TestMovingAverage(void) {
+    FilterStage stage;
+    int32_t samples[16];
+
+    InitMovingAverage(&stage, 3);
+    Fill(samples, 4, 0);
+    stage.process(&stage, samples, 4);
+    CHECK(samples[3] == 0);
+
+    // Degrau de 0 a 800: sobe 100 por amostra até cobrir a janela de 8
+    Fill(samples, 10, 800);
+    stage.process(&stage, samples, 10);
+    for (int i = 0; i < 8; i++)
+        CHECK(samples[i] == 100 * (i + 1));
+    CHECK(samples[9] == 800);
+}
+
+static void TestMedian(void) {
+    FilterStage stage;
+    int32_t samples[] = { 100, 100, 4000, 100, 100, 0, 100, 100, 4000, 4000, 100, 100 };
+
+    // Picos de até duas amostras seguidas somem com janela de 5
+    InitMedianFilter(&stage, 5);
+    stage.process(&stage, samples, count_of(samples));
+    for (size_t i = 0; i < count_of(samples); i++)
+        CHECK(samples[i] == 100);
+
+    // Tamanho par vira o ímpar seguinte
+    InitMedianFilter(&stage, 4);
+    CHECK(stage.state.median.size == 5);
+}
+
+static void TestExpAverage(void) {
+    FilterStage stage;
+    int32_t samples[BLOCK];
+
+    InitExpAverage(&stage, 3);
+    Fill(samples, 1, 0);
+    stage.process(&stage, samples, 1);
+
+    // Degrau de 0 a 1000: 1000 * (1 - (7/8)^n), arredondado
+    Fill(samples, BLOCK, 1000);
+    stage.process(&stage, samples, BLOCK);
+    double expected = 0;
+    for (int i = 0; i < 8; i++) {
+        expected += (1000 - expected) / 8;
+        CHECK(abs(samples[i] - (int32_t)(expected + 0.5)) <= 1);
+    }
+    CHECK(samples[BLOCK - 1] == 1000);
+}
+
+// Um bloco inteiro e amostra por amostra dão o mesmo resultado
+static void TestBlockIndependence(void) {
+    FilterStage whole[3], single[3];
+    FilterPipeline wholePipeline = { whole, 3 }, singlePipeline = { single, 3 };
+    int32_t block[BLOCK], one;
+
+    InitMedianFilter(&whole[0], 5);
+    InitMovingAverage(&whole[1], 3);
+    InitExpAverage(&whole[2], 2);
+    memcpy(single, whole, sizeof(whole));
+
+    srand(1);
+    for (int i = 0; i < BLOCK; i++)
+        block[i] = 2048 + rand() % 400 - 200 + (i % 17 == 0 ? 1500 : 0);
+
+    int32_t input[BLOCK];
+    memcpy(input, block, sizeof(block));
+    PipelineProcess(&wholePipeline, block, BLOCK);
+    for (int i = 0; i < BLOCK; i++) {
+        one = input[i];
+        PipelineProcess(&singlePipeline, &one, 1);
+        CHECK(one == block[i]);
+    }
+}
+
+typedef struct
+{
+    FilterPipeline pipeline;
+    int32_t input[BLOCK];
+    int32_t samples[BLOCK];
+} StageBench;
+
+static void RunStage(void *context) {
+    StageBench *bench = context;
+    memcpy(bench->samples, bench->input, sizeof(bench->samples));
+    PipelineProcess(&bench->pipeline, bench->samples, BLOCK);
+}
+
+static void MeasureStage(const char *name, FilterStage *stages, uint8_t count, uint32_t iterations) {
+    static StageBench bench;
+    bench.pipeline = (FilterPipeline){ stages, count };
+    srand(2);
+    for (int i = 0; i < BLOCK; i++)
+        bench.input[i] = 2048 + rand() % 200;
+    printf("%-36s %8.2f ns/amostra\n", name, Measure(RunStage, &bench, iterations) / BLOCK);
+}
+
+int main(int argc, char **argv) {
+    uint32_t iterations = DEFAULT_ITERATIONS;
+    if (argc == 3 && strcmp(argv[1], "--iterations") == 0)
+        iterations = strtoul(argv[2], NULL, 0);
+
+    TestMovingAverage();
+    TestMedian();
+    TestExpAverage();
+    TestBlockIndependence();
+
+    if (iterations) {
+        FilterStage stages[2];
+        InitMovingAverage(&stages[0], 3);
+        MeasureStage("média móvel (8)", stages, 1, iterations);
+        InitMedianFilter(&stages[0], 5);
+        MeasureStage("mediana (5)", stages, 1, iterations);
+        InitExpAverage(&stages[0], 3);
+        MeasureStage("média exponencial Q16 (1/8)", stages, 1, iterations);
+        InitMedianFilter(&stages[0], 5);
+        InitMovingAverage(&stages[1], 3);
+        MeasureStage("eixo X: mediana + média móvel", stages, 2, iterations);
+    }
+    return CHECK_RESULT();
+}
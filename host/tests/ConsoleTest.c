@@ -0,0 +1,74 @@
+/**
+ * Console de comandos (src/Console.c): conversão de números, recusa de bytes
+ * fora da faixa e execução de uma linha lida em fatias
+ */
+
+#include <string.h>
+#include "Console.h"
+#include "Hal.h"
+#include "Check.h"
+
+// Entrada serial roteirizada
+static const char *input = "";
+
+int HalConsoleRead(void) {
+    return *input ? *input++ : HAL_NO_INPUT;
+}
+
+static uint8_t lastBytes[3];
+static int runs;
+
+static void CommandBytes(int argc, char **argv) {
+    for (int i = 1; i < argc && i <= 3; i++) {
+        if (!ConsoleParseByte(argv[i], &lastBytes[i - 1]))
+            return;
+    }
+    runs++;
+}
+
+static void TestParse(void) {
+    uint32_t number;
+    uint8_t byte;
+
+    CHECK(ConsoleParseNumber("4294967295", &number) && number == UINT32_MAX);
+    CHECK(!ConsoleParseNumber("4294967296", &number));
+    CHECK(ConsoleParseNumber("0x1F", &number) && number == 31);
+    CHECK(!ConsoleParseNumber("", &number));
+    CHECK(!ConsoleParseNumber("0x", &number));
+    CHECK(!ConsoleParseNumber("12a", &number));
+
+    CHECK(ConsoleParseByte("255", &byte) && byte == 255);
+    CHECK(ConsoleParseByte("0xff", &byte) && byte == 255);
+    CHECK(ConsoleParseByte("0", &byte) && byte == 0);
+
+    // Antes passavam truncados (256 virava 0)
+    byte = 7;
+    CHECK(!ConsoleParseByte("256", &byte) && byte == 7);
+    CHECK(!ConsoleParseByte("0x100", &byte) && byte == 7);
+    CHECK(!ConsoleParseByte("4294967296", &byte) && byte == 7);
+}
+
+static void TestDispatch(void) {
+    static const ConsoleCommand commands[] = {
+        { "bytes", "<a> <b> <c>", CommandBytes },
+    };
+    InitConsole(commands, 1);
+
+    // A linha chega em fatias de CONSOLE_SLICE_CHARS caracteres
+    input = "bytes 1 0x20 255\n";
+    for (int i = 0; i < 4; i++)
+        ConsoleTask();
+    CHECK(runs == 1);
+    CHECK(lastBytes[0] == 1 && lastBytes[1] == 32 && lastBytes[2] == 255);
+
+    input = "bytes 1 2 300\n";
+    for (int i = 0; i < 4; i++)
+        ConsoleTask();
+    CHECK(runs == 1);
+}
+
+int main(void) {
+    TestParse();
+    TestDispatch();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,140 @@
+/**
+ * Tráfego I2C do driver SSD1306 contra o painel emulado: o primeiro envio
+ * transmite o quadro inteiro, a mudança de um dígito transmite só a janela do
+ * dígito e nada muda quando nada foi redesenhado. Depois de cada envio, o
+ * conteúdo reconstruído do painel tem de ser igual ao framebuffer.
+ */
+
+#include <string.h>
+#include "SdkMock.h"
+#include "ssd1306.h"
+#include "Widgets.h"
+#include "Check.h"
+
+static void InitDisplay(ssd1306_t *ssd) {
+    MockReset();
+    ssd1306_init(ssd, WIDTH, HEIGHT, false, 0x3C, i2c1);
+    ssd1306_config(ssd);
+    ssd1306_fill(ssd, false);
+}
+
+static bool PanelMatches(const ssd1306_t *ssd) {
+    return memcmp(mockPanel.gddram, ssd->ram_buffer + 1, ssd->bufsize - 1) == 0;
+}
+
+static uint32_t CountSetPixels(const ssd1306_t *ssd) {
+    uint32_t count = 0;
+    for (size_t i = 1; i < ssd->bufsize; i++)
+        count += __builtin_popcount(ssd->ram_buffer[i]);
+    return count;
+}
+
+// Coordenadas fora da tela não podem tocar no buffer nem nas faixas sujas
+static void TestClipping(void) {
+    ssd1306_t ssd;
+    InitDisplay(&ssd);
+    ssd1306_flush(&ssd);
+
+    ssd1306_t before = ssd;
+    uint8_t *buffer = malloc(ssd.bufsize);
+    memcpy(buffer, ssd.ram_buffer, ssd.bufsize);
+
+    for (unsigned y = HEIGHT; y <= 255; y++)
+        ssd1306_pixel(&ssd, 10, y, true);
+    for (unsigned x = WIDTH; x <= 255; x++)
+        ssd1306_pixel(&ssd, x, 10, true);
+    ssd1306_line(&ssd, 130, 70, 250, 250, true);
+
+    CHECK(memcmp(buffer, ssd.ram_buffer, ssd.bufsize) == 0);
+    CHECK(ssd.dirty_pages == 0);
+    CHECK(memcmp(before.dirty_x0, ssd.dirty_x0, sizeof(ssd.dirty_x0)) == 0);
+    CHECK(memcmp(before.dirty_x1, ssd.dirty_x1, sizeof(ssd.dirty_x1)) == 0);
+    CHECK(ssd.gddram == before.gddram && ssd.synced);
+
+    // Retângulo que passa das bordas: só os lados visíveis, recortados
+    ssd1306_rect(&ssd, 60, 120, 200, 200, true, false);
+    CHECK(CountSetPixels(&ssd) == 8 + 3);
+    ssd1306_fill(&ssd, false);
+    ssd1306_rect(&ssd, 60, 120, 200, 200, true, true);
+    CHECK(CountSetPixels(&ssd) == 8 * 4);
+
+    free(buffer);
+    free(ssd.ram_buffer);
+    free(ssd.gddram);
+}
+
+static void DrawLayout(ssd1306_t *ssd, NumericField *field, uint8_t value) {
+    DrawLabel(ssd, "TEMPERATURA", 0, 16);
+    InitNumericField(field, 96, 16, 3, 120);
+    UpdateNumericField(ssd, field, value, true);
+}
+
+static void TestFlushTraffic(void) {
+    ssd1306_t ssd;
+    NumericField field;
+    InitDisplay(&ssd);
+    DrawLayout(&ssd, &field, 25);
+
+    MockResetCounters();
+    CHECK(ssd1306_flush(&ssd) == ssd.bufsize);
+    CHECK(mockPanel.dataBytes == WIDTH * HEIGHT / 8);
+    CHECK(PanelMatches(&ssd));
+
+    // 25 -> 26: só as colunas do último dígito, em uma página
+    UpdateNumericField(&ssd, &field, 26, true);
+    MockResetCounters();
+    size_t sent = ssd1306_flush(&ssd);
+    CHECK(sent > 1 && sent <= 1 + 8);
+    CHECK(mockPanel.dataBytes == sent - 1);
+    CHECK(mockPanel.transactions == 2);   // Janela e dados
+    CHECK(PanelMatches(&ssd));
+
+    // Sem mudança, e redesenhar o mesmo conteúdo, não gera tráfego
+    MockResetCounters();
+    CHECK(ssd1306_flush(&ssd) == 0);
+    DrawLayout(&ssd, &field, 26);
+    CHECK(ssd1306_flush(&ssd) == 0);
+    CHECK(mockPanel.transactions == 0 && mockPanel.bytes == 0);
+
+    free(ssd.ram_buffer);
+    free(ssd.gddram);
+}
+
+// O mesmo pelo caminho do firmware: troca de buffers e envio por DMA
+static void TestAsyncTraffic(void) {
+    ssd1306_t ssd;
+    NumericField field;
+    InitDisplay(&ssd);
+    ssd1306_init_dma(&ssd);
+    DrawLayout(&ssd, &field, 25);
+
+    MockResetCounters();
+    CHECK(ssd1306_swap_buffers(&ssd));
+    ssd1306_send_data_async(&ssd);
+    MockService();
+    CHECK(mockPanel.dataBytes == WIDTH * HEIGHT / 8);
+    CHECK(PanelMatches(&ssd));
+
+    UpdateNumericField(&ssd, &field, 26, true);
+    MockResetCounters();
+    CHECK(ssd1306_swap_buffers(&ssd));
+    ssd1306_send_data_async(&ssd);
+    MockService();
+    CHECK(mockPanel.dataBytes > 0 && mockPanel.dataBytes <= 8);
+    CHECK(PanelMatches(&ssd));
+
+    MockResetCounters();
+    CHECK(!ssd1306_swap_buffers(&ssd));
+    CHECK(mockPanel.transactions == 0);
+
+    free(ssd.front_buffer);
+    free(ssd.ram_buffer);
+    free(ssd.gddram);
+}
+
+int main(void) {
+    TestClipping();
+    TestFlushTraffic();
+    TestAsyncTraffic();
+    return CHECK_RESULT();
+}
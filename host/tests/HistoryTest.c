@@ -0,0 +1,307 @@
+/**
+ * Histórico na flash (src/History.c) sobre a flash NOR emulada em arquivo
+ * (host/FileFlash.c): leitura de volta, rodízio dos segmentos, falhas na
+ * troca de segmento, reinicializações que continuam no mesmo segmento, quedas
+ * de energia com reinicialização a partir do arquivo e, por fim, vazão, taxa
+ * de compressão e apagamentos em uma semana simulada
+ *
+ * Uso: HistoryTest [arquivo da imagem]
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "FileFlash.h"
+#include "History.h"
+#include "Bench.h"
+#include "Check.h"
+
+#define MAX_RECORDS 40000
+#define MINUTE 60
+#define WEEK_RECORDS (7 * 24 * 60)
+
+typedef struct
+{
+    uint32_t timeS;
+    uint8_t values[HISTORY_VALUE_COUNT];
+} Record;
+
+// Registros acrescentados, em ordem de tempo (cada ciclo tem a própria base de tempo)
+static Record appended[MAX_RECORDS];
+static uint32_t appendedCount;
+
+// Registros devolvidos por ReplayHistory
+static Record replayed[MAX_RECORDS];
+static uint32_t replayedCount;
+static uint32_t lastBoot;
+static bool bootsInOrder;
+
+static uint32_t seed = 1;
+
+static uint32_t Random(uint32_t range) {
+    seed = seed * 1664525u + 1013904223u;
+    return (seed >> 8) % range;
+}
+
+// Leitura de um minuto: na maior parte do tempo nada muda; às vezes um valor anda um pouco
+static void NextValues(uint8_t *values) {
+    if (Random(4) == 0) {
+        uint32_t i = Random(HISTORY_VALUE_COUNT);
+        int value = values[i] + (int)Random(11) - 5;
+        values[i] = value < 0 ? 0 : value > 255 ? 255 : value;
+    }
+}
+
+static bool Append(uint8_t *values, uint32_t timeS) {
+    NextValues(values);
+    if (appendedCount < MAX_RECORDS) {
+        appended[appendedCount].timeS = timeS;
+        memcpy(appended[appendedCount].values, values, HISTORY_VALUE_COUNT);
+        appendedCount++;
+    }
+    return AppendHistory(values, timeS);
+}
+
+static void Collect(void *context, uint32_t boot, uint32_t timeS, const uint8_t *values) {
+    if (replayedCount && boot < lastBoot)
+        bootsInOrder = false;
+    lastBoot = boot;
+    if (replayedCount < MAX_RECORDS) {
+        replayed[replayedCount].timeS = timeS;
+        memcpy(replayed[replayedCount].values, values, HISTORY_VALUE_COUNT);
+        replayedCount++;
+    }
+}
+
+static void Replay(void) {
+    replayedCount = 0;
+    bootsInOrder = true;
+    ReplayHistory(Collect, NULL);
+}
+
+static const Record *FindAppended(uint32_t timeS) {
+    uint32_t low = 0, high = appendedCount;
+    while (low < high) {
+        uint32_t mid = (low + high) / 2;
+        if (appended[mid].timeS < timeS)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low < appendedCount && appended[low].timeS == timeS ? &appended[low] : NULL;
+}
+
+/**
+ * Todo registro lido de volta tem de ter sido acrescentado, com os mesmos
+ * valores, e em ordem de tempo
+ * @return Quantidade de registros conferidos
+ */
+static uint32_t CheckReplayed(void) {
+    uint32_t bad = 0;
+    for (uint32_t i = 0; i < replayedCount; i++) {
+        const Record *expected = FindAppended(replayed[i].timeS);
+        if (!expected || memcmp(expected->values, replayed[i].values, HISTORY_VALUE_COUNT) != 0 ||
+            (i > 0 && replayed[i].timeS <= replayed[i - 1].timeS))
+            bad++;
+    }
+    CHECK(bad == 0);
+    CHECK(bootsInOrder);
+    CHECK(fileFlashStats.violations == 0);
+    CHECK(fileFlashStats.misaligned == 0);
+    return replayedCount;
+}
+
+static void Reset(void) {
+    OpenFileFlash(NULL);
+    appendedCount = 0;
+    seed = 1;
+}
+
+static void TestRoundTrip(void) {
+    uint8_t values[HISTORY_VALUE_COUNT] = { 0 };
+    Reset();
+    CHECK(InitHistory(&fileFlash, 0));
+
+    for (uint32_t i = 0; i < 500; i++)
+        CHECK(Append(values, i * MINUTE));
+    CHECK(CommitHistory());
+
+    Replay();
+    CHECK(CheckReplayed() == 500);
+}
+
+// Mais registros do que a região comporta: restam os mais recentes, contíguos
+static void TestWrap(void) {
+    uint8_t values[HISTORY_VALUE_COUNT] = { 0 };
+    Reset();
+    CHECK(InitHistory(&fileFlash, 0));
+
+    for (uint32_t i = 0; i < MAX_RECORDS; i++)
+        CHECK(Append(values, i * MINUTE));
+    CHECK(CommitHistory());
+
+    Replay();
+    uint32_t kept = CheckReplayed();
+    CHECK(kept >= (HISTORY_SECTORS - 1) * (HISTORY_PAGES - 1) * HISTORY_COMMIT_RECORDS);
+    CHECK(kept > 0 && replayed[kept - 1].timeS == appended[appendedCount - 1].timeS);
+    CHECK(kept > 0 && replayed[0].timeS == appended[appendedCount - kept].timeS);
+
+    // Reinicializar continua no segmento mais recente; nada é apagado
+    CHECK(InitHistory(&fileFlash, 0));
+    Replay();
+    CHECK(CheckReplayed() == kept);
+    CHECK(replayedCount > 0 && replayed[replayedCount - 1].timeS == appended[appendedCount - 1].timeS);
+}
+
+// Muitas reinicializações com poucos registros cada: todas continuam no
+// mesmo segmento, então o histórico sobrevive e só um setor é apagado
+static void TestReboots(void) {
+    uint8_t values[HISTORY_VALUE_COUNT] = { 0 };
+    const uint32_t boots = 4 * HISTORY_SECTORS;
+    Reset();
+
+    for (uint32_t cycle = 0; cycle < boots; cycle++) {
+        uint32_t base = cycle * 1000000;
+        CHECK(InitHistory(&fileFlash, base));
+        for (uint32_t i = 1; i <= 3; i++)
+            CHECK(Append(values, base + i * MINUTE));
+        CHECK(CommitHistory());
+    }
+
+    Replay();
+    CHECK(CheckReplayed() == appendedCount);
+    CHECK(lastBoot == boots - 1);
+    CHECK(fileFlashStats.erases == 1);
+}
+
+// Falhas avulsas de gravação e apagamento, inclusive na troca de segmento,
+// com a região já toda usada: nada pode ser gravado fora de um segmento aberto
+static void TestWriteFailures(void) {
+    uint8_t values[HISTORY_VALUE_COUNT] = { 0 };
+    Reset();
+    CHECK(InitHistory(&fileFlash, 0));
+
+    uint32_t failures = 0;
+    for (uint32_t i = 0; i < MAX_RECORDS; i++) {
+        if (Random(40) == 0)
+            FileFlashFailAt(1, false);
+        failures += !Append(values, i * MINUTE);
+    }
+    CommitHistory();
+
+    CHECK(failures > 0);
+    Replay();
+    CHECK(CheckReplayed() > 0);
+}
+
+// Quedas de energia em pontos aleatórios; a cada uma a placa reinicia a
+// partir do arquivo e continua depois do último trecho válido. O último ciclo
+// termina sem falha
+static void TestPowerLoss(const char *path) {
+    uint8_t values[HISTORY_VALUE_COUNT] = { 0 };
+    OpenFileFlash(NULL);
+    remove(path);
+    CHECK(OpenFileFlash(path));
+    appendedCount = 0;
+    seed = 7;
+
+    const uint32_t cycles = 60;
+    for (uint32_t cycle = 0; cycle < cycles; cycle++) {
+        bool last = cycle == cycles - 1;
+        uint32_t base = cycle * 1000000;
+        uint32_t firstRecord = appendedCount;
+
+        if (!last)
+            FileFlashFailAt(1 + Random(60), true);
+        if (!InitHistory(&fileFlash, base)) {
+            FileFlashPowerOn();
+            CHECK(OpenFileFlash(path));
+            continue;
+        }
+
+        for (uint32_t i = 1; i <= 400; i++) {
+            if (!Append(values, base + i * MINUTE) && !last)
+                break;
+        }
+
+        if (last) {
+            CHECK(CommitHistory());
+            Replay();
+            CheckReplayed();
+
+            // O último ciclo, sem falhas, aparece inteiro
+            uint32_t found = 0;
+            for (uint32_t i = 0; i < replayedCount; i++)
+                found += replayed[i].timeS > base;
+            CHECK(found == appendedCount - firstRecord);
+        }
+
+        // Reinicialização: a flash volta do arquivo
+        FileFlashPowerOn();
+        CHECK(OpenFileFlash(path));
+    }
+
+    CloseFileFlash();
+    remove(path);
+}
+
+/**
+ * Conta os bytes de registros nos trechos válidos da região
+ */
+static uint32_t PayloadBytes(void) {
+    uint32_t total = 0;
+    for (uint32_t sector = 0; sector < HISTORY_SECTORS; sector++) {
+        HistorySegmentHeader header;
+        fileFlash.read(sector * FLASH_SECTOR_SIZE, &header, sizeof(header));
+        if (header.magic != HISTORY_MAGIC)
+            continue;
+        for (uint32_t page = 1; page < HISTORY_PAGES; page++) {
+            uint8_t data[FLASH_PAGE_SIZE];
+            fileFlash.read(sector * FLASH_SECTOR_SIZE + page * FLASH_PAGE_SIZE, data, sizeof(data));
+            for (uint32_t offset = 0; offset + HISTORY_CHUNK_HEADER < FLASH_PAGE_SIZE && data[offset] != 0xFF;
+                 offset += HISTORY_CHUNK_HEADER + data[offset])
+                total += data[offset];
+        }
+    }
+    return total;
+}
+
+// Uma semana, um registro por minuto
+static void TestWeekThroughput(void) {
+    uint8_t values[HISTORY_VALUE_COUNT] = { 0 };
+    Reset();
+    CHECK(InitHistory(&fileFlash, 0));
+
+    uint64_t start = NowNs();
+    for (uint32_t i = 1; i <= WEEK_RECORDS; i++)
+        CHECK(Append(values, i * MINUTE));
+    CHECK(CommitHistory());
+    double ns = (double)(NowNs() - start) / WEEK_RECORDS;
+
+    Replay();
+    uint32_t kept = CheckReplayed();
+    uint32_t raw = sizeof(uint32_t) + HISTORY_VALUE_COUNT;
+    double payload = (double)PayloadBytes() / kept;
+    double programmed = (double)fileFlashStats.bytesProgrammed / WEEK_RECORDS;
+
+    printf("semana: %u registros, %u na flash (%.1f dias)\n", WEEK_RECORDS, kept, kept / 1440.0);
+    printf("AppendHistory: %.0f ns/registro (%.0f registros/s)\n", ns, 1e9 / ns);
+    printf("registro bruto %u bytes, codificado %.2f bytes (%.1fx), gravado %.2f bytes (%.1fx)\n",
+           raw, payload, raw / payload, programmed, raw / programmed);
+    printf("apagamentos: %u setores (%.1f por dia)\n", fileFlashStats.erases, fileFlashStats.erases / 7.0);
+    CHECK(raw / payload > 4);
+
+    // Páginas cheias: o que vai à flash é pouco mais que os registros
+    CHECK(programmed < 1.1 * payload);
+}
+
+int main(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : "history_test.bin";
+
+    TestRoundTrip();
+    TestWrap();
+    TestReboots();
+    TestWriteFailures();
+    TestPowerLoss(path);
+    TestWeekThroughput();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,78 @@
+/**
+ * Fila de quadros da matriz contra o DMA e o PIO emulados: quadros iguais não
+ * são reenviados, a fila aceita no máximo MATRIX_QUEUE_SIZE quadros pendentes
+ * e o último recusado segue depois por FlushMatrix, o intervalo entre quadros
+ * segue a profundidade do FIFO com a junção TX e a fila continua andando
+ * quando o alarme do fim de quadro chega atrasado.
+ */
+
+#include "SdkMock.h"
+#include "Leds.h"
+#include "MatrixDma.h"
+#include "Check.h"
+
+static RGB colors[3] = { { 28, 39, 53 }, { 0, 50, 0 }, { 50, 0, 0 } };
+static const refs pio = { pio0, 0, 0 };
+
+static void TestQueue(void) {
+    MockResetCounters();
+    CHECK(Draw(Drawing(1), colors));
+    CHECK(!Draw(Drawing(1), colors));          // Igual ao último: descartado
+    MockService();
+    CHECK(mockMatrix.frames == 1);
+    CHECK(mockMatrix.lastCount == NUM_PIXELS);
+
+    // Sem MockService o primeiro quadro não termina: só cabem MATRIX_QUEUE_SIZE
+    MockResetCounters();
+    int accepted = 0;
+    for (int i = 0; i < MATRIX_QUEUE_SIZE + 2; i++)
+        accepted += Draw(Drawing(i & 1 ? 1 : 2), colors);
+    CHECK(accepted == MATRIX_QUEUE_SIZE);
+    CHECK(!FlushMatrix());
+    MockService();
+    CHECK(mockMatrix.frames == MATRIX_QUEUE_SIZE);
+
+    // O último quadro recusado fica pendente e segue quando a fila anda
+    CHECK(FlushMatrix());
+    MockService();
+    CHECK(mockMatrix.frames == MATRIX_QUEUE_SIZE + 1);
+    CHECK(FlushMatrix());
+}
+
+// FIFO unido (8 palavras) mais a palavra no OSR e o reset entre quadros
+static void TestFrameGap(void) {
+    const uint64_t gap = (2 * MATRIX_FIFO_DEPTH + 1) * MATRIX_WORD_US + MATRIX_RESET_US;
+    MockResetCounters();
+    uint64_t start = mockTimeUs;
+    CHECK(Draw(Drawing(0), colors));
+    CHECK(Draw(Drawing(1), colors));
+    MockService();
+    CHECK(mockMatrix.frames == 2);
+    CHECK(mockTimeUs - start == 2 * gap);
+}
+
+// Prazo do alarme já passado no fim de um quadro: a fila não pode ficar presa
+static void TestAlarmMissed(void) {
+    MockResetCounters();
+    mockAlarmMissed = true;
+    CHECK(Draw(Drawing(0), colors));
+    CHECK(Draw(Drawing(1), colors));
+    MockService();
+    CHECK(mockMatrix.frames == 2);
+
+    CHECK(Draw(Drawing(2), colors));
+    MockService();
+    CHECK(mockMatrix.frames == 3);
+}
+
+int main(void) {
+    MockReset();
+    SetMatrixBrightness(MATRIX_DEFAULT_BRIGHTNESS);
+    pio_matrix_program_init(pio.ref, pio.stateMachine, pio.offset, LED_MATRIX);
+    InitMatrixDMA(pio);
+
+    TestQueue();
+    TestFrameGap();
+    TestAlarmMissed();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,90 @@
+/**
+ * Anel de telemetria (src/Telemetry.c): desligado por padrão sem contar
+ * descartes, pacotes com sincronismo e checksum quando ligado e marca de
+ * perda no primeiro registro aceito depois do anel cheio
+ */
+
+#include <string.h>
+#include "Telemetry.h"
+#include "Hal.h"
+#include "Check.h"
+
+#define FRAME_SIZE (3 + sizeof(TelemetryRecord) + 2)
+
+// Saída serial capturada
+static uint8_t output[4096];
+static size_t outputLen;
+
+void HalSerialWrite(const void *data, size_t len) {
+    memcpy(output + outputLen, data, len);
+    outputLen += len;
+}
+
+static uint16_t Fletcher16(const uint8_t *data, size_t len) {
+    uint16_t sum1 = 0, sum2 = 0;
+    for (size_t i = 0; i < len; i++) {
+        sum1 = (sum1 + data[i]) % 255;
+        sum2 = (sum2 + sum1) % 255;
+    }
+    return (sum2 << 8) | sum1;
+}
+
+static bool ValidFrame(const uint8_t *frame, TelemetryRecord *record) {
+    if (frame[0] != TELEMETRY_SYNC0 || frame[1] != TELEMETRY_SYNC1 || frame[2] != sizeof(TelemetryRecord))
+        return false;
+    uint16_t checksum = frame[FRAME_SIZE - 2] | frame[FRAME_SIZE - 1] << 8;
+    memcpy(record, &frame[3], sizeof(*record));
+    return checksum == Fletcher16(&frame[2], 1 + sizeof(TelemetryRecord));
+}
+
+static void Drain(int times) {
+    for (int i = 0; i < times; i++)
+        DrainTelemetry();
+}
+
+int main(void) {
+    TelemetryRecord record = { .timeUs = 1, .zone = 2, .values = { 25, 60, 50 } };
+    TelemetryRecord decoded;
+
+    // Desligada: nada entra no anel, nada sai na serial, nada é perda
+    CHECK(!TelemetryEnabled());
+    CHECK(!PushTelemetry(&record));
+    Drain(2);
+    CHECK(outputLen == 0);
+    CHECK(DroppedTelemetry() == 0);
+
+    EnableTelemetry(true);
+    CHECK(PushTelemetry(&record));
+    Drain(1);
+    CHECK(outputLen == FRAME_SIZE);
+    CHECK(ValidFrame(output, &decoded));
+    CHECK(decoded.timeUs == 1 && decoded.zone == 2 && decoded.values[1] == 60 && decoded.flags == 0);
+
+    // Anel cheio: descarta e marca o próximo registro aceito
+    outputLen = 0;
+    for (uint32_t i = 0; i < TELEMETRY_RING_SIZE; i++) {
+        record.timeUs = 100 + i;
+        CHECK(PushTelemetry(&record));
+    }
+    CHECK(!PushTelemetry(&record));
+    CHECK(DroppedTelemetry() == 1);
+    Drain(1);
+    record.timeUs = 999;
+    CHECK(PushTelemetry(&record));
+    Drain(TELEMETRY_RING_SIZE);
+    CHECK(outputLen == (TELEMETRY_RING_SIZE + 1) * FRAME_SIZE);
+    CHECK(ValidFrame(output + TELEMETRY_RING_SIZE * FRAME_SIZE, &decoded));
+    CHECK(decoded.timeUs == 999 && (decoded.flags & TELEMETRY_FLAG_DROPPED));
+
+    // Desligar interrompe o envio no meio do anel; religar descarta o que sobrou
+    CHECK(PushTelemetry(&record));
+    EnableTelemetry(false);
+    outputLen = 0;
+    Drain(2);
+    CHECK(outputLen == 0);
+    EnableTelemetry(true);
+    Drain(2);
+    CHECK(outputLen == 0);
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,10 @@
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Checksum comum ao histórico na flash e aos pacotes de telemetria
+uint16_t Fletcher16(const uint8_t *data, size_t len);
+
+#endif
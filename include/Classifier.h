@@ -0,0 +1,82 @@
+#ifndef CLASSIFIER_H
+#define CLASSIFIER_H
+
+#include <General.h>
+
+// Classificação de severidade por tabela. Cada grandeza tem uma tabela de 256
+// entradas, indexada diretamente pelo valor, gerada em tempo de compilação a
+// partir das faixas abaixo (src/Classifier.cpp) e reconstruída quando as faixas
+// são trocadas em execução (SetSeverityBands). Cada entrada guarda:
+//   bits 0-2: severidade de entrada (faixas nominais), com SEVERITY_LOW abaixo
+//             do mínimo normal
+//   bits 3-4: severidade de saída pelo lado de cima (máximos estreitados pela
+//             histerese)
+//   bit 5:    SEVERITY_HOLD_LOW, valor ainda a menos da histerese do mínimo normal
+// Uma severidade só piora ao cruzar o limite nominal e só melhora depois de
+// voltar a histerese inteira para dentro da faixa, sem oscilar na borda. A
+// histerese vale para o lado por onde a grandeza saiu: a memória de cada zona
+// guarda SEVERITY_LOW junto com o crítico abaixo do mínimo, e um valor que sobe
+// de lá direto para perto do máximo normal é normal, não alerta.
+//
+// Para monitorar outra grandeza basta acrescentar uma linha à lista:
+// QUANTITY(nome, mínimo normal, máximo normal, máximo de alerta, histerese)
+
+#define CLASSIFIER_QUANTITIES(QUANTITY) \
+    QUANTITY(TEMPERATURE, TEMP_NORMAL_MIN, TEMP_NORMAL_MAX, TEMP_MEDIUM_MAX, TEMP_HYSTERESIS) \
+    QUANTITY(HUMIDITY, HUMIDITY_NORMAL_MIN, HUMIDITY_NORMAL_MAX, HUMIDITY_MEDIUM_MAX, HUMIDITY_HYSTERESIS) \
+    QUANTITY(BRIGHTNESS, BRIGHTNESS_NORMAL_MIN, BRIGHTNESS_NORMAL_MAX, BRIGHTNESS_MEDIUM_MAX, BRIGHTNESS_HYSTERESIS)
+
+#define SEVERITY_LEVEL_MASK 0x03      // Severidade (Severity) de uma entrada ou memória
+#define SEVERITY_LOW 0x04             // Crítico por estar abaixo do mínimo normal
+#define SEVERITY_ENTER_MASK 0x07
+#define SEVERITY_EXIT_SHIFT 3
+#define SEVERITY_HOLD_LOW 0x20
+
+// Severidades em ordem crescente: a severidade combinada é a maior delas
+typedef enum
+{
+    SEVERITY_NORMAL,
+    SEVERITY_WARNING,
+    SEVERITY_CRITICAL,
+    SEVERITY_COUNT
+} Severity;
+
+// Grandezas monitoradas, na ordem de CLASSIFIER_QUANTITIES
+typedef enum
+{
+#define QUANTITY_ENUM(name, normalMin, normalMax, mediumMax, hysteresis) QUANTITY_##name,
+    CLASSIFIER_QUANTITIES(QUANTITY_ENUM)
+#undef QUANTITY_ENUM
+    QUANTITY_COUNT
+} Quantity;
+
+// Faixas de uma grandeza, como na lista CLASSIFIER_QUANTITIES
+typedef struct
+{
+    uint8_t normalMin;
+    uint8_t normalMax;
+    uint8_t mediumMax;
+    uint8_t hysteresis;
+} SeverityBands;
+
+// Tabela de uma grandeza, indexada pelo valor
+typedef struct
+{
+    uint8_t entries[256];
+} SeverityTable;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern SeverityTable severityTables[QUANTITY_COUNT];
+
+void GetSeverityBands(Quantity quantity, SeverityBands *bands);
+bool SetSeverityBands(Quantity quantity, const SeverityBands *bands);
+void ClassifyBatch(Quantity quantity, const uint8_t *values, uint8_t *severity, uint8_t *combined, uint16_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef CONDITIONING_H
+#define CONDITIONING_H
+
+#include <General.h>
+
+#define MOVING_AVERAGE_MAX_SHIFT 4  // Janela máxima da média móvel: 2^4 = 16 amostras
+#define MEDIAN_MAX_SIZE 7           // Janela máxima do filtro de mediana (ímpar)
+#define EMA_FRACTION_BITS 16        // Parte fracionária do estado da média exponencial (Q16)
+
+// Média móvel com janela de 2^shift amostras: soma corrente e deslocamento, sem divisão
+typedef struct
+{
+    int32_t history[1 << MOVING_AVERAGE_MAX_SHIFT];
+    int32_t sum;
+    uint8_t shift;
+    uint8_t index;
+    bool primed;
+} MovingAverage;
+
+// Mediana deslizante de N amostras, para remover picos isolados
+typedef struct
+{
+    int32_t history[MEDIAN_MAX_SIZE];
+    uint8_t size;
+    uint8_t index;
+    bool primed;
+} MedianFilter;
+
+// Média exponencial com alfa = 2^-shift, estado em Q16
+typedef struct
+{
+    int32_t value;
+    uint8_t shift;
+    bool primed;
+} ExpAverage;
+
+// Estágio de condicionamento: processa um bloco de amostras no próprio buffer
+typedef struct FilterStage
+{
+    void (*process)(struct FilterStage *stage, int32_t *samples, uint16_t count);
+    union
+    {
+        MovingAverage movingAverage;
+        MedianFilter median;
+        ExpAverage exp;
+    } state;
+} FilterStage;
+
+// Sequência de estágios aplicados em ordem
+typedef struct
+{
+    FilterStage *stages;
+    uint8_t count;
+} FilterPipeline;
+
+// Funções de configuração dos estágios
+void InitMovingAverage(FilterStage *stage, uint8_t windowShift);
+void InitMedianFilter(FilterStage *stage, uint8_t size);
+void InitExpAverage(FilterStage *stage, uint8_t alphaShift);
+
+// Processamento de um bloco pelo pipeline
+void PipelineProcess(FilterPipeline *pipeline, int32_t *samples, uint16_t count);
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <General.h>
+
+#define CONSOLE_LINE_SIZE 64      // Maior linha aceita, incluindo o terminador
+#define CONSOLE_MAX_ARGS 8        // Maior quantidade de palavras em uma linha
+#define CONSOLE_SLICE_CHARS 16    // Caracteres lidos por execução da tarefa
+#define CONSOLE_POLL_US 20000     // Período da tarefa do console
+
+// Console de comandos por linha na stdio (USB/UART). A tarefa lê poucos
+// caracteres por vez, sem esperar, para um buffer fixo; ao fim da linha ela é
+// dividida em palavras no próprio buffer e o comando é procurado na tabela
+// fornecida pela aplicação. Sem heap e sem sscanf
+
+// Comando do console: argv[0] é o próprio nome
+typedef struct
+{
+    const char *name;
+    const char *usage;     // Argumentos, mostrados por "help"
+    void (*run)(int argc, char **argv);
+} ConsoleCommand;
+
+// Funções do console
+void InitConsole(const ConsoleCommand *commands, uint8_t count);
+void ConsoleTask(void);
+bool ConsoleParseNumber(const char *text, uint32_t *value);
+bool ConsoleParseByte(const char *text, uint8_t *value);
+
+#endif
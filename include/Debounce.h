@@ -0,0 +1,20 @@
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include <General.h>
+
+#define DEBOUNCE_SAMPLE_US 5000     // Período de amostragem dos botões
+#define DEBOUNCE_SAMPLES 4          // Amostras iguais seguidas para aceitar uma mudança (20 ms)
+#define LONG_PRESS_MS 1000          // Tempo pressionado até o evento de toque longo
+#define LONG_PRESS_TICKS (LONG_PRESS_MS * 1000 / DEBOUNCE_SAMPLE_US)
+
+// Debounce de todos os botões de uma vez: um temporizador lê todos os pinos com
+// HalReadButtons() a cada DEBOUNCE_SAMPLE_US e um contador vertical de 2 bits
+// (um bit de cada contador por pino, na mesma palavra) aceita a mudança de um
+// pino depois de DEBOUNCE_SAMPLES leituras iguais. O custo é uma interrupção por
+// período, independente do ruído dos contatos. Os eventos de toque, soltura e
+// toque longo vão para a fila de InputEvents
+
+void InitDebounce(uint32_t pinMask);
+
+#endif
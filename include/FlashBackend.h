@@ -0,0 +1,21 @@
+#ifndef FLASH_BACKEND_H
+#define FLASH_BACKEND_H
+
+#include <General.h>
+#include "hardware/flash.h"
+
+// Acesso a uma região de flash reservada, com endereços relativos ao início
+// dela. Apagamento por setor (FLASH_SECTOR_SIZE) e gravação por página
+// (FLASH_PAGE_SIZE), ambos alinhados
+typedef struct
+{
+    uint32_t size;                                                   // Tamanho da região em bytes
+    void (*read)(uint32_t offset, void *data, size_t len);
+    bool (*erase)(uint32_t offset, size_t len);
+    bool (*program)(uint32_t offset, const void *data, size_t len);
+} FlashBackend;
+
+// Região no fim da flash da placa, fora do alcance do programa
+extern const FlashBackend picoFlash;
+
+#endif
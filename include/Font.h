@@ -1,69 +1,126 @@
-// Fontes para A-Z, a-z e 0-9.
+#ifndef FONT_H
+#define FONT_H
 
-static uint8_t font[] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // Nothing
-    0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e, 0x00, // 0
-    0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00, // 1
-    0x30, 0x49, 0x49, 0x49, 0x49, 0x46, 0x00, 0x00, // 2
-    0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 3
-    0x3f, 0x20, 0x20, 0x78, 0x20, 0x20, 0x00, 0x00, // 4
-    0x4f, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, // 5
-    0x3f, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00, // 6
-    0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00, // 7
-    0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 8
-    0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00, // 9
+// Fonte 8x8 para todos os caracteres ASCII imprimíveis (0x20 a 0x7E), em ordem.
+// Cada glifo tem 8 colunas e, em cada byte, o bit 0 é a linha de cima: o mesmo
+// formato de uma página da GDDRAM do SSD1306, então desenhar é copiar bytes.
+//
+// A lista é expandida em tempo de compilação com a macro GLYPH(c, b0, ..., b7),
+// gerando a tabela indexada diretamente por (c - FONT_FIRST_CHAR) e as larguras
+// da variante proporcional.
 
-    0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00, // A
-    0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00, // B
-    0x7e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x00, // C
-    0x7f, 0x41, 0x41, 0x41, 0x41, 0x41, 0x7e, 0x00, // D
-    0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x00, // E
-    0x7f, 0x09, 0x09, 0x09, 0x09, 0x01, 0x01, 0x00, // F
-    0x7f, 0x41, 0x41, 0x41, 0x51, 0x51, 0x73, 0x00, // G
-    0x7f, 0x08, 0x08, 0x08, 0x08, 0x08, 0x7f, 0x00, // H
-    0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, // I
-    0x21, 0x41, 0x41, 0x3f, 0x01, 0x01, 0x01, 0x00, // J
-    0x00, 0x7f, 0x08, 0x08, 0x14, 0x22, 0x41, 0x00, // K
-    0x7f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, // L
-    0x7f, 0x02, 0x04, 0x08, 0x04, 0x02, 0x7f, 0x00, // M
-    0x7f, 0x02, 0x04, 0x08, 0x10, 0x20, 0x7f, 0x00, // N
-    0x3e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x3e, 0x00, // O
-    0x7f, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00, // P
-    0x3e, 0x41, 0x41, 0x49, 0x51, 0x61, 0x7e, 0x00, // Q
-    0x7f, 0x11, 0x11, 0x11, 0x31, 0x51, 0x0e, 0x00, // R
-    0x46, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, // S
-    0x01, 0x01, 0x01, 0x7f, 0x01, 0x01, 0x01, 0x00, // T
-    0x3f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x3f, 0x00, // U
-    0x0f, 0x10, 0x20, 0x40, 0x20, 0x10, 0x0f, 0x00, // V
-    0x7f, 0x20, 0x10, 0x08, 0x10, 0x20, 0x7f, 0x00, // W
-    0x00, 0x41, 0x22, 0x14, 0x14, 0x22, 0x41, 0x00, // X
-    0x01, 0x02, 0x04, 0x78, 0x04, 0x02, 0x01, 0x00, // Y
-    0x41, 0x61, 0x59, 0x45, 0x43, 0x41, 0x00, 0x00, // Z
+#define FONT_FIRST_CHAR 0x20
+#define FONT_LAST_CHAR 0x7E
+#define FONT_GLYPH_COUNT (FONT_LAST_CHAR - FONT_FIRST_CHAR + 1)
+#define FONT_WIDTH 8
 
-    0x79, 0x49, 0x49, 0x49, 0x7f, 0x00, 0x00, 0x00, // a
-    0x7f, 0x48, 0x48, 0x48, 0x78, 0x00, 0x00, 0x00, // b
-    0x7c, 0x42, 0x42, 0x42, 0x42, 0x42, 0x00, 0x00, // c
-    0x78, 0x48, 0x48, 0x48, 0x7f, 0x00, 0x00, 0x00, // d
-    0x7e, 0x49, 0x49, 0x49, 0x4f, 0x00, 0x00, 0x00, // e
-    0x08, 0x08, 0x7f, 0x09, 0x09, 0x00, 0x00, 0x00, // f
-    0x5e, 0x52, 0x52, 0x52, 0x7f, 0x00, 0x00, 0x00, // g
-    0x7f, 0x08, 0x08, 0x08, 0x70, 0x00, 0x00, 0x00, // h
-    0x7d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // i
-    0x40, 0x40, 0x40, 0x3d, 0x00, 0x00, 0x00, 0x00, // j
-    0x7f, 0x10, 0x28, 0x44, 0x00, 0x00, 0x00, 0x00, // k
-    0x01, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // l
-    0x7c, 0x08, 0x04, 0x7c, 0x04, 0x08, 0x7c, 0x00, // m
-    0x7c, 0x08, 0x04, 0x04, 0x78, 0x00, 0x00, 0x00, // n
-    0x7c, 0x44, 0x44, 0x44, 0x7c, 0x00, 0x00, 0x00, // o
-    0x7f, 0x12, 0x12, 0x1e, 0x00, 0x00, 0x00, 0x00, // p
-    0x1e, 0x12, 0x12, 0x7f, 0x00, 0x00, 0x00, 0x00, // q
-    0x7c, 0x08, 0x04, 0x04, 0x18, 0x00, 0x00, 0x00, // r
-    0x5c, 0x54, 0x54, 0x74, 0x00, 0x00, 0x00, 0x00, // s
-    0x04, 0x3f, 0x42, 0x42, 0x00, 0x00, 0x00, 0x00, // t
-    0x3e, 0x40, 0x40, 0x20, 0x7e, 0x00, 0x00, 0x00, // u
-    0x3e, 0x40, 0x40, 0x40, 0x3e, 0x00, 0x00, 0x00, // v
-    0x3e, 0x40, 0x3e, 0x40, 0x3e, 0x00, 0x00, 0x00, // w
-    0x44, 0x28, 0x10, 0x28, 0x44, 0x00, 0x00, 0x00, // x
-    0x02, 0x44, 0x48, 0x50, 0x3e, 0x00, 0x00, 0x00, // y
-    0x44, 0x64, 0x54, 0x48, 0x44, 0x00, 0x00, 0x00  // z
-};
\ No newline at end of file
+// Espaço entre glifos e largura do espaço na variante proporcional
+#define FONT_PROP_SPACING 1
+#define FONT_PROP_SPACE_ADVANCE 3
+
+// Primeira coluna não vazia de um glifo (0 para o glifo vazio)
+#define FONT_LEFT(b0, b1, b2, b3, b4, b5, b6, b7) \
+    ((b0) ? 0 : (b1) ? 1 : (b2) ? 2 : (b3) ? 3 : (b4) ? 4 : (b5) ? 5 : (b6) ? 6 : (b7) ? 7 : 0)
+
+// Quantidade de colunas até a última coluna não vazia de um glifo
+#define FONT_RIGHT(b0, b1, b2, b3, b4, b5, b6, b7) \
+    ((b7) ? 8 : (b6) ? 7 : (b5) ? 6 : (b4) ? 5 : (b3) ? 4 : (b2) ? 3 : (b1) ? 2 : (b0) ? 1 : 0)
+
+#define FONT_GLYPHS(GLYPH) \
+    GLYPH(' '  , 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH('!'  , 0x00, 0x00, 0x00, 0x5f, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH('"'  , 0x00, 0x00, 0x07, 0x00, 0x07, 0x00, 0x00, 0x00) \
+    GLYPH('#'  , 0x00, 0x14, 0x7f, 0x14, 0x7f, 0x14, 0x00, 0x00) \
+    GLYPH('$'  , 0x00, 0x24, 0x2a, 0x7f, 0x2a, 0x12, 0x00, 0x00) \
+    GLYPH('%'  , 0x00, 0x23, 0x13, 0x08, 0x64, 0x62, 0x00, 0x00) \
+    GLYPH('&'  , 0x00, 0x36, 0x49, 0x56, 0x20, 0x50, 0x00, 0x00) \
+    GLYPH('\'' , 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH('('  , 0x00, 0x00, 0x1c, 0x22, 0x41, 0x00, 0x00, 0x00) \
+    GLYPH(')'  , 0x00, 0x00, 0x41, 0x22, 0x1c, 0x00, 0x00, 0x00) \
+    GLYPH('*'  , 0x00, 0x14, 0x08, 0x3e, 0x08, 0x14, 0x00, 0x00) \
+    GLYPH('+'  , 0x00, 0x08, 0x08, 0x3e, 0x08, 0x08, 0x00, 0x00) \
+    GLYPH(','  , 0x00, 0x00, 0x80, 0x60, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH('-'  , 0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00) \
+    GLYPH('.'  , 0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH('/'  , 0x00, 0x20, 0x10, 0x08, 0x04, 0x02, 0x00, 0x00) \
+    GLYPH('0'  , 0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e, 0x00) \
+    GLYPH('1'  , 0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00) \
+    GLYPH('2'  , 0x30, 0x49, 0x49, 0x49, 0x49, 0x46, 0x00, 0x00) \
+    GLYPH('3'  , 0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00) \
+    GLYPH('4'  , 0x3f, 0x20, 0x20, 0x78, 0x20, 0x20, 0x00, 0x00) \
+    GLYPH('5'  , 0x4f, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00) \
+    GLYPH('6'  , 0x3f, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00) \
+    GLYPH('7'  , 0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00) \
+    GLYPH('8'  , 0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00) \
+    GLYPH('9'  , 0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00) \
+    GLYPH(':'  , 0x00, 0x00, 0x36, 0x36, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH(';'  , 0x00, 0x00, 0x80, 0x76, 0x36, 0x00, 0x00, 0x00) \
+    GLYPH('<'  , 0x00, 0x08, 0x14, 0x22, 0x41, 0x00, 0x00, 0x00) \
+    GLYPH('='  , 0x00, 0x14, 0x14, 0x14, 0x14, 0x14, 0x00, 0x00) \
+    GLYPH('>'  , 0x00, 0x00, 0x41, 0x22, 0x14, 0x08, 0x00, 0x00) \
+    GLYPH('?'  , 0x00, 0x02, 0x01, 0x51, 0x09, 0x06, 0x00, 0x00) \
+    GLYPH('@'  , 0x00, 0x3e, 0x41, 0x5d, 0x55, 0x1e, 0x00, 0x00) \
+    GLYPH('A'  , 0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00) \
+    GLYPH('B'  , 0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00) \
+    GLYPH('C'  , 0x7e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x00) \
+    GLYPH('D'  , 0x7f, 0x41, 0x41, 0x41, 0x41, 0x41, 0x7e, 0x00) \
+    GLYPH('E'  , 0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x00) \
+    GLYPH('F'  , 0x7f, 0x09, 0x09, 0x09, 0x09, 0x01, 0x01, 0x00) \
+    GLYPH('G'  , 0x7f, 0x41, 0x41, 0x41, 0x51, 0x51, 0x73, 0x00) \
+    GLYPH('H'  , 0x7f, 0x08, 0x08, 0x08, 0x08, 0x08, 0x7f, 0x00) \
+    GLYPH('I'  , 0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH('J'  , 0x21, 0x41, 0x41, 0x3f, 0x01, 0x01, 0x01, 0x00) \
+    GLYPH('K'  , 0x00, 0x7f, 0x08, 0x08, 0x14, 0x22, 0x41, 0x00) \
+    GLYPH('L'  , 0x7f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00) \
+    GLYPH('M'  , 0x7f, 0x02, 0x04, 0x08, 0x04, 0x02, 0x7f, 0x00) \
+    GLYPH('N'  , 0x7f, 0x02, 0x04, 0x08, 0x10, 0x20, 0x7f, 0x00) \
+    GLYPH('O'  , 0x3e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x3e, 0x00) \
+    GLYPH('P'  , 0x7f, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00) \
+    GLYPH('Q'  , 0x3e, 0x41, 0x41, 0x49, 0x51, 0x61, 0x7e, 0x00) \
+    GLYPH('R'  , 0x7f, 0x11, 0x11, 0x11, 0x31, 0x51, 0x0e, 0x00) \
+    GLYPH('S'  , 0x46, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00) \
+    GLYPH('T'  , 0x01, 0x01, 0x01, 0x7f, 0x01, 0x01, 0x01, 0x00) \
+    GLYPH('U'  , 0x3f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x3f, 0x00) \
+    GLYPH('V'  , 0x0f, 0x10, 0x20, 0x40, 0x20, 0x10, 0x0f, 0x00) \
+    GLYPH('W'  , 0x7f, 0x20, 0x10, 0x08, 0x10, 0x20, 0x7f, 0x00) \
+    GLYPH('X'  , 0x00, 0x41, 0x22, 0x14, 0x14, 0x22, 0x41, 0x00) \
+    GLYPH('Y'  , 0x01, 0x02, 0x04, 0x78, 0x04, 0x02, 0x01, 0x00) \
+    GLYPH('Z'  , 0x41, 0x61, 0x59, 0x45, 0x43, 0x41, 0x00, 0x00) \
+    GLYPH('['  , 0x00, 0x00, 0x7f, 0x41, 0x41, 0x00, 0x00, 0x00) \
+    GLYPH('\\' , 0x00, 0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x00) \
+    GLYPH(']'  , 0x00, 0x00, 0x41, 0x41, 0x7f, 0x00, 0x00, 0x00) \
+    GLYPH('^'  , 0x00, 0x04, 0x02, 0x01, 0x02, 0x04, 0x00, 0x00) \
+    GLYPH('_'  , 0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00) \
+    GLYPH('`'  , 0x00, 0x00, 0x01, 0x02, 0x04, 0x00, 0x00, 0x00) \
+    GLYPH('a'  , 0x79, 0x49, 0x49, 0x49, 0x7f, 0x00, 0x00, 0x00) \
+    GLYPH('b'  , 0x7f, 0x48, 0x48, 0x48, 0x78, 0x00, 0x00, 0x00) \
+    GLYPH('c'  , 0x7c, 0x42, 0x42, 0x42, 0x42, 0x42, 0x00, 0x00) \
+    GLYPH('d'  , 0x78, 0x48, 0x48, 0x48, 0x7f, 0x00, 0x00, 0x00) \
+    GLYPH('e'  , 0x7e, 0x49, 0x49, 0x49, 0x4f, 0x00, 0x00, 0x00) \
+    GLYPH('f'  , 0x08, 0x08, 0x7f, 0x09, 0x09, 0x00, 0x00, 0x00) \
+    GLYPH('g'  , 0x5e, 0x52, 0x52, 0x52, 0x7f, 0x00, 0x00, 0x00) \
+    GLYPH('h'  , 0x7f, 0x08, 0x08, 0x08, 0x70, 0x00, 0x00, 0x00) \
+    GLYPH('i'  , 0x7d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH('j'  , 0x40, 0x40, 0x40, 0x3d, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH('k'  , 0x7f, 0x10, 0x28, 0x44, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH('l'  , 0x01, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH('m'  , 0x7c, 0x08, 0x04, 0x7c, 0x04, 0x08, 0x7c, 0x00) \
+    GLYPH('n'  , 0x7c, 0x08, 0x04, 0x04, 0x78, 0x00, 0x00, 0x00) \
+    GLYPH('o'  , 0x7c, 0x44, 0x44, 0x44, 0x7c, 0x00, 0x00, 0x00) \
+    GLYPH('p'  , 0x7f, 0x12, 0x12, 0x1e, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH('q'  , 0x1e, 0x12, 0x12, 0x7f, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH('r'  , 0x7c, 0x08, 0x04, 0x04, 0x18, 0x00, 0x00, 0x00) \
+    GLYPH('s'  , 0x5c, 0x54, 0x54, 0x74, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH('t'  , 0x04, 0x3f, 0x42, 0x42, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH('u'  , 0x3e, 0x40, 0x40, 0x20, 0x7e, 0x00, 0x00, 0x00) \
+    GLYPH('v'  , 0x3e, 0x40, 0x40, 0x40, 0x3e, 0x00, 0x00, 0x00) \
+    GLYPH('w'  , 0x3e, 0x40, 0x3e, 0x40, 0x3e, 0x00, 0x00, 0x00) \
+    GLYPH('x'  , 0x44, 0x28, 0x10, 0x28, 0x44, 0x00, 0x00, 0x00) \
+    GLYPH('y'  , 0x02, 0x44, 0x48, 0x50, 0x3e, 0x00, 0x00, 0x00) \
+    GLYPH('z'  , 0x44, 0x64, 0x54, 0x48, 0x44, 0x00, 0x00, 0x00) \
+    GLYPH('{'  , 0x00, 0x00, 0x08, 0x36, 0x41, 0x00, 0x00, 0x00) \
+    GLYPH('|'  , 0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00) \
+    GLYPH('}'  , 0x00, 0x00, 0x41, 0x36, 0x08, 0x00, 0x00, 0x00) \
+    GLYPH('~'  , 0x00, 0x08, 0x04, 0x08, 0x10, 0x08, 0x00, 0x00)
+
+#endif
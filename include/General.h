@@ -9,10 +9,22 @@
 #include "hardware/pwm.h"
 #include "hardware/clocks.h"
 #include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
 #include "pico/bootrom.h"
 #include "pio_matrix.pio.h"
 #include "hardware/i2c.h"
 
+// 1: o núcleo 1 desenha o display e controla o I2C (definido pelo CMake)
+#ifndef DUAL_CORE
+#define DUAL_CORE 0
+#endif
+
+// 1: mede a duração de cada estágio do laço (definido pelo CMake)
+#ifndef PROFILING
+#define PROFILING 0
+#endif
+
 #define BUTTON_A 5   // Pino do Botão A
 #define BUTTON_B 6   // Pino do Botão B
 #define GREEN_LED 11 // Pino do LED verde
@@ -28,19 +40,40 @@
 #define HIGHEST_AXIS_VALUE 4082 // Maior valor lido pelo ADC do joystick
 #define VRX_PIN 26              // Pino do joystick eixo X
 #define VRY_PIN 27              // Pino do joystick eixo Y
+#define VRX_INPUT 1             // Entrada do ADC do eixo X
+#define VRY_INPUT 0             // Entrada do ADC do eixo Y
+#define AXIS_RANGE (HIGHEST_AXIS_VALUE - LOWEST_AXIS_VALUE)
+// Fator em Q16 que leva a posição do eixo (0 a AXIS_RANGE) a 0..max, arredondado para cima
+#define AXIS_SCALE_Q16(max) ((((uint32_t)(max) << 16) + AXIS_RANGE - 1) / AXIS_RANGE)
+#define TEMP_AXIS_MAX 50        // Temperatura com o joystick no fim do curso
+#define HUMIDITY_AXIS_MAX 60    // Umidade com o joystick no fim do curso
+#define BRIGHTNESS_AXIS_MAX 70  // Luminosidade com o joystick no fim do curso
+#define ZONE_AXIS_LOW 1024      // Eixo Y abaixo disto volta uma zona
+#define ZONE_AXIS_HIGH 3072     // Eixo Y acima disto avança uma zona
+#define ZONE_REPEAT_MS 300      // Intervalo de repetição da troca de zona com o joystick inclinado
+#define SENSOR_PERIOD_US 5000      // Leitura do joystick a 200 Hz
+#define CONTROL_PERIOD_US 20000    // Zonas, classificação e alarme a 50 Hz
+#define DISPLAY_PERIOD_US 100000   // Atualização do display a 10 Hz
 #define PWM_WRAP 31250           // Resolução do PWM
 #define BUZZER_A 21
 
+// Faixas de classificação: abaixo de NORMAL_MIN e acima de MEDIUM_MAX é crítico,
+// entre NORMAL_MAX e MEDIUM_MAX é alerta. A histerese é a distância que o valor
+// precisa voltar para dentro da faixa antes de a severidade melhorar
 #define TEMP_NORMAL_MIN 16
 #define TEMP_NORMAL_MAX 26
 #define TEMP_MEDIUM_MAX 36
+#define TEMP_HYSTERESIS 1
 
 #define HUMIDITY_NORMAL_MIN 40
 #define HUMIDITY_NORMAL_MAX 60
 #define HUMIDITY_MEDIUM_MAX 80
+#define HUMIDITY_HYSTERESIS 2
+
 #define BRIGHTNESS_NORMAL_MIN 30
 #define BRIGHTNESS_NORMAL_MAX 50
 #define BRIGHTNESS_MEDIUM_MAX 70
+#define BRIGHTNESS_HYSTERESIS 2
 
 // Struct para manipulação da PIO
 typedef struct PIORefs
@@ -53,9 +86,9 @@ typedef struct PIORefs
 // Struct para manipulação das cores dos LEDs
 typedef struct RGB
 {
-    int8_t red;
-    int8_t green;
-    int8_t blue;
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
 } RGB;
 
 // Funções de configuração
@@ -0,0 +1,55 @@
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "ssd1306.h"
+#include "FlashBackend.h"
+
+#define HAL_MAX_TICKERS 2     // Temporizadores periódicos ativos ao mesmo tempo (botões e animação)
+#define HAL_ADC_BLOCK 64      // Amostras de uma entrada do ADC guardadas entre duas leituras
+#define HAL_NO_INPUT (-1)     // HalConsoleRead sem caractere disponível
+
+// Camada fina entre a lógica de controle e o hardware: inicialização dos
+// periféricos, relógio, espera do escalonador, temporizadores, botões, ADC,
+// LEDs indicadores, buzzer, matriz, display, flash do histórico, console e
+// núcleo 1. A lógica só enxerga estas funções, e o backend é escolhido na
+// ligação: src/HalPico.c na placa, sobre os drivers (Sampler.c, MatrixDma.c,
+// ssd1306.c, FlashBackend.c), e host/HalLinux.c no computador, com relógio
+// virtual em que HalSleepUntil apenas avança o tempo
+//
+// O display continua sendo desenhado no ssd1306_t (Widgets.h e ssd1306.h);
+// só a inicialização do barramento e o envio passam por aqui
+
+// Tarefa de um temporizador periódico, chamada em contexto de interrupção
+typedef void (*HalTick)(void);
+
+// Inicialização
+void HalInit(void);
+void HalLaunchCore1(void (*entry)(void));
+
+// Relógio, espera e temporizadores
+uint64_t HalTimeUs(void);
+void HalSleepUntil(uint64_t deadlineUs);
+void HalWake(void);
+int HalStartTicker(uint32_t periodUs, HalTick tick);
+void HalStopTicker(int ticker);
+
+// Entradas
+uint32_t HalReadButtons(uint32_t pinMask);
+uint16_t HalAdcRead(uint8_t input, uint16_t *out, uint16_t max, uint16_t *cursor);
+
+// Saídas
+void HalSetLed(uint8_t gpio, bool on);
+void HalSetBuzzer(uint16_t level);
+bool HalMatrixSubmit(const uint32_t *frame);
+void HalDisplayInit(ssd1306_t *ssd);
+void HalDisplaySend(ssd1306_t *ssd);
+
+// Armazenamento e serial
+const FlashBackend *HalHistoryFlash(void);
+int HalConsoleRead(void);
+void HalSerialWrite(const void *data, size_t len);
+
+#endif
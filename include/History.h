@@ -0,0 +1,66 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <General.h>
+#include "FlashBackend.h"
+#include "Zones.h"
+
+// Histórico de amostras em log somente de acréscimo na flash.
+//
+// A região é dividida em segmentos de um setor, usados em rodízio (o mais
+// antigo é apagado para dar lugar ao novo), o que distribui o desgaste. A
+// página 0 de cada segmento guarda o cabeçalho com o número de sequência; as
+// demais guardam trechos, cada um com tamanho, checksum e registros inteiros.
+// Um trecho novo é gravado na parte ainda apagada da página (a gravação de
+// 0xFF deixa a flash como está), então as páginas enchem de verdade.
+// Cada registro é codificado em varint em relação ao anterior:
+//   varint(segundos desde o registro anterior) varint(n)
+//   n x { varint(índice do valor) varint(zigzag(diferença)) }
+// O primeiro registro de um segmento é relativo a zero, então cada segmento
+// é decodificado sozinho. Os registros se acumulam na RAM e um trecho só é
+// gravado quando a página enche ou a cada HISTORY_COMMIT_RECORDS registros.
+// Na inicialização a escrita continua no segmento mais recente, depois do
+// último trecho válido, com um marcador de reinício (n = HISTORY_RESTART,
+// seguido de varint(boot) varint(segundos desde o boot)) que zera a base da
+// codificação. Um segmento novo só é aberto quando o atual enche.
+// Uma queda de energia perde no máximo os registros ainda não gravados
+
+#define HISTORY_SECTORS 16                                      // Segmentos na região
+#define HISTORY_REGION_SIZE (HISTORY_SECTORS * FLASH_SECTOR_SIZE)
+#define HISTORY_PERIOD_US 60000000                              // Um registro por minuto
+#define HISTORY_COMMIT_RECORDS 15                               // Grava um trecho a cada 15 registros
+
+#define HISTORY_MAGIC 0x474F4C48                                // "HLOG"
+#define HISTORY_PAGES (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)     // Páginas por segmento
+#define HISTORY_CHUNK_HEADER 3                                  // Tamanho e checksum de um trecho
+#define HISTORY_CHUNK_PAYLOAD (FLASH_PAGE_SIZE - HISTORY_CHUNK_HEADER)
+#define HISTORY_SEGMENT_PAYLOAD ((HISTORY_PAGES - 1) * HISTORY_CHUNK_PAYLOAD)
+#define HISTORY_VALUE_COUNT (QUANTITY_COUNT * ZONE_COUNT)       // Valores por registro, na ordem de ZoneState.values
+#define HISTORY_MAX_RECORD (5 + 3 + HISTORY_VALUE_COUNT * 4)    // Pior caso de um registro codificado
+#define HISTORY_RESTART (HISTORY_VALUE_COUNT + 1)               // n do marcador de reinício
+#define HISTORY_MAX_RESTART (1 + 3 + 5 + 5)                     // Pior caso do marcador de reinício
+
+// Cabeçalho de segmento, no início da página 0
+typedef struct
+{
+    uint32_t magic;
+    uint32_t sequence;        // Cresce a cada segmento aberto
+    uint32_t boot;            // Cresce a cada inicialização
+    uint32_t startS;          // Segundos desde o boot na abertura do segmento
+    uint16_t zoneCount;       // Formato dos registros
+    uint8_t quantityCount;
+    uint8_t reserved;
+    uint16_t checksum;        // Fletcher-16 dos campos anteriores
+    uint16_t padding;
+} HistorySegmentHeader;
+
+// Chamada para cada registro, do mais antigo ao mais recente
+typedef void (*HistoryVisitor)(void *context, uint32_t boot, uint32_t timeS, const uint8_t *values);
+
+// Funções do histórico
+bool InitHistory(const FlashBackend *backend, uint32_t nowS);
+bool AppendHistory(const uint8_t *values, uint32_t nowS);
+bool CommitHistory(void);
+void ReplayHistory(HistoryVisitor visit, void *context);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef INPUT_EVENTS_H
+#define INPUT_EVENTS_H
+
+#include <General.h>
+
+#define INPUT_QUEUE_BITS 4                        // Fila com 2^4 eventos
+#define INPUT_QUEUE_SIZE (1u << INPUT_QUEUE_BITS)
+
+// Tipos de evento de entrada
+typedef enum
+{
+    INPUT_PRESS,         // Botão pressionado
+    INPUT_RELEASE,       // Botão solto
+    INPUT_LONG_PRESS     // Botão mantido pressionado por LONG_PRESS_MS
+} InputEventType;
+
+// Evento de entrada com o instante em que ocorreu
+typedef struct
+{
+    uint32_t timeUs;    // µs desde o boot (32 bits, comparar por diferença)
+    uint8_t gpio;       // Pino de origem
+    uint8_t type;       // InputEventType
+} InputEvent;
+
+// Fila sem trava com um produtor (interrupção do debounce) e um consumidor (laço principal).
+// Cada lado escreve somente o próprio índice; os índices crescem livremente e
+// a posição no vetor é o índice módulo INPUT_QUEUE_SIZE
+bool PushInputEvent(uint8_t gpio, InputEventType type, uint32_t timeUs);
+bool PopInputEvent(InputEvent *event);
+uint32_t DroppedInputEvents(void);
+
+#endif
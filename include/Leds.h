@@ -3,12 +3,49 @@
 
 #define NUM_PIXELS 25 // Quantidade de pixels/LEDs da matriz
 
+#define MATRIX_GAMMA 2.2f              // Gama aplicada às cores da matriz
+#define MATRIX_DEFAULT_BRIGHTNESS 255  // Brilho global inicial (0 a 255)
+#define ANIMATION_TICK_MS 20           // Período do temporizador das animações
+
 #include <General.h>
 
+// Padrão da matriz com 2 bits por LED: 0 = apagado, 1 a 3 = cor 0 a 2 da paleta
+// O LED i do padrão ocupa os bits 2i e 2i+1 (mesma ordem dos antigos vetores de desenho)
+typedef uint64_t Pattern;
+
+// Monta uma linha de 5 LEDs e um padrão completo a partir de 5 linhas
+#define PATTERN_ROW(a, b, c, d, e) \
+    ((uint64_t)(a) | (uint64_t)(b) << 2 | (uint64_t)(c) << 4 | (uint64_t)(d) << 6 | (uint64_t)(e) << 8)
+#define PATTERN(r0, r1, r2, r3, r4) \
+    ((Pattern)(r0) | (Pattern)(r1) << 10 | (Pattern)(r2) << 20 | (Pattern)(r3) << 30 | (Pattern)(r4) << 40)
+
+// Quadro-chave de uma animação: padrão exibido e paleta no início do quadro.
+// Durante o quadro a paleta transita para a do quadro-chave seguinte
+typedef struct
+{
+    Pattern pattern;     // Padrão exibido durante o quadro-chave
+    RGB palette[3];      // Cores 0 a 2 no início do quadro-chave
+    uint16_t durationMs; // Duração do quadro-chave
+} Keyframe;
+
+typedef struct
+{
+    const Keyframe *frames;
+    uint8_t count;
+    bool loop;           // Reinicia ao fim; caso contrário mantém o último quadro
+} Animation;
+
+extern const Animation alertPulse;   // Pulso vermelho para alertas críticos
+extern const Animation fillBar;      // Barra que enche de baixo para cima
+
 // Funções de manipulação de cor e desenhos dos LEDs
+void SetMatrixBrightness(uint8_t);
 uint32_t RGBMatrix(RGB color);
-void Draw(double *, uint32_t, refs, RGB *);
-double *Drawing(int);
+void PlayAnimation(const Animation *);
+void StopAnimation(void);
+bool Draw(Pattern, RGB *);
+bool FlushMatrix(void);
+Pattern Drawing(int);
 void BlinkRGBLed(int);
 
 #endif
\ No newline at end of file
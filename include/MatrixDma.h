@@ -0,0 +1,18 @@
+#ifndef MATRIX_DMA_H
+#define MATRIX_DMA_H
+
+#include <General.h>
+
+#define MATRIX_QUEUE_SIZE 4    // Quadros pendentes na fila de envio (potência de 2)
+#define MATRIX_FIFO_DEPTH 4    // Palavras do FIFO de transmissão do PIO (o dobro com a junção TX)
+#define MATRIX_WORD_US 30      // Uma palavra de 24 bits a 800 kHz
+#define MATRIX_RESET_US 300    // Tempo em nível baixo que encerra um quadro nos WS2812
+
+// Envio dos quadros da matriz WS2812 por DMA para o FIFO do PIO, com uma fila
+// curta de quadros pendentes. Usado pelo backend da placa (HalMatrixSubmit)
+
+// Funções do envio por DMA
+void InitMatrixDMA(refs);
+bool MatrixSubmit(const uint32_t *);
+
+#endif
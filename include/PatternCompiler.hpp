@@ -0,0 +1,91 @@
+#ifndef PATTERN_COMPILER_HPP
+#define PATTERN_COMPILER_HPP
+
+// Compilador de padrões da matriz 5x5 em tempo de compilação.
+// Os desenhos são escritos como arte ASCII, linha de cima primeiro, e viram
+// constantes na flash já na ordem em que a máquina de estado pio_matrix envia
+// os LEDs, incluindo o remapeamento da ligação em serpentina da placa.
+//
+// Caracteres aceitos: '.' ou ' ' = apagado, '#' = cor 1, '+' = cor 2, '*' = cor 3.
+// Qualquer outro caractere, ou um desenho com tamanho diferente de 25, é erro
+// de compilação quando o resultado é usado como constexpr.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Patterns.h"
+
+namespace matrix
+{
+    constexpr int size = 5;
+
+    // Posição no padrão compactado (ordem dos antigos vetores de desenho) do LED
+    // na linha row (0 = topo) e coluna col: as linhas ímpares são espelhadas
+    constexpr int slot(int row, int col) { return row * size + ((row & 1) ? (size - 1 - col) : col); }
+
+    // Posição na ordem de envio: Draw envia do último slot para o primeiro
+    constexpr int wire(int row, int col) { return NUM_PIXELS - 1 - slot(row, col); }
+
+    // Sem definição e não constexpr: chamá-la durante a avaliação em tempo de
+    // compilação interrompe a compilação apontando o caractere inválido
+    void invalid_character_in_matrix_art();
+
+    // Índice de paleta (0 a 3) de um caractere do desenho
+    constexpr uint8_t palette_index(char c)
+    {
+        switch (c)
+        {
+        case '.':
+        case ' ':
+            return 0;
+        case '#':
+            return 1;
+        case '+':
+            return 2;
+        case '*':
+            return 3;
+        default:
+            invalid_character_in_matrix_art();
+            return 0;
+        }
+    }
+
+    // Palavra GRB no formato do programa pio_matrix (G | R | B | 0)
+    constexpr uint32_t grb(uint8_t r, uint8_t g, uint8_t b)
+    {
+        return (uint32_t(g) << 24) | (uint32_t(r) << 16) | (uint32_t(b) << 8);
+    }
+
+    template <size_t N>
+    constexpr void check_size(const char (&)[N])
+    {
+        static_assert(N == NUM_PIXELS + 1, "o desenho deve ter 5 linhas de 5 caracteres");
+    }
+
+    // Converte o desenho no padrão compactado de 2 bits por LED usado por Draw
+    template <size_t N>
+    constexpr Pattern compile_pattern(const char (&art)[N])
+    {
+        check_size(art);
+        Pattern pattern = 0;
+        for (int row = 0; row < size; ++row)
+            for (int col = 0; col < size; ++col)
+                pattern |= Pattern(palette_index(art[row * size + col])) << (2 * slot(row, col));
+        return pattern;
+    }
+
+    // Converte o desenho no quadro completo, na ordem de envio, com cores fixas
+    template <size_t N>
+    constexpr MatrixFrame compile_frame(const char (&art)[N], uint32_t color1, uint32_t color2 = 0, uint32_t color3 = 0)
+    {
+        check_size(art);
+        const uint32_t palette[4] = {0, color1, color2, color3};
+        MatrixFrame frame{};
+        for (int row = 0; row < size; ++row)
+            for (int col = 0; col < size; ++col)
+                frame.words[wire(row, col)] = palette[palette_index(art[row * size + col])];
+        return frame;
+    }
+}
+
+#endif
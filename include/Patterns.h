@@ -0,0 +1,51 @@
+#ifndef PATTERNS_H
+#define PATTERNS_H
+
+#include <Leds.h>
+
+// Quadro completo da matriz, já na ordem de envio ao PIO
+typedef struct
+{
+    uint32_t words[NUM_PIXELS];
+} MatrixFrame;
+
+// Símbolos de estado pré-compilados (src/Patterns.cpp)
+enum StatusGlyph
+{
+    GLYPH_DIGIT_0,
+    GLYPH_DIGIT_1,
+    GLYPH_DIGIT_2,
+    GLYPH_DIGIT_3,
+    GLYPH_DIGIT_4,
+    GLYPH_DIGIT_5,
+    GLYPH_DIGIT_6,
+    GLYPH_DIGIT_7,
+    GLYPH_DIGIT_8,
+    GLYPH_DIGIT_9,
+    GLYPH_CHECK,
+    GLYPH_CROSS,
+    GLYPH_ARROW_UP,
+    GLYPH_ARROW_DOWN,
+    GLYPH_DROP,
+    GLYPH_SUN,
+    GLYPH_THERMOMETER,
+    GLYPH_EXCLAMATION,
+    GLYPH_QUESTION,
+    GLYPH_HEART,
+    STATUS_GLYPH_COUNT
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const Pattern basePatterns[3];                       // Padrões usados por Drawing()
+extern const MatrixFrame statusGlyphs[STATUS_GLYPH_COUNT];  // Símbolos com cores fixas
+
+bool DrawFrame(const MatrixFrame *);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef PROFILING_H
+#define PROFILING_H
+
+#include <General.h>
+#include <Hal.h>
+
+// Instrumentação por estágio, ativada com PROFILING=1 (opção do CMake).
+// Cada estágio acumula mínimo, máximo, média e um histograma com faixas em
+// potências de 2 do tempo em µs, em memória estática. Desativada, as macros
+// não geram código nenhum. Cada estágio é medido sempre no mesmo núcleo (com
+// DUAL_CORE, UpdateDisplay no núcleo 1), então as estatísticas dele têm um só
+// escritor; o console lê e zera pelo protocolo de sequência de Snapshot.h
+
+#define PROFILE_BUCKETS 16    // Faixas: 0 µs, 1 µs, 2-3 µs, 4-7 µs, ... e o resto na última
+
+#define PROFILE_STAGES(STAGE) \
+    STAGE(READ_JOYSTICK, "ReadJoystick") \
+    STAGE(UPDATE_SYSTEM_STATE, "UpdateSystemState") \
+    STAGE(UPDATE_INDICATORS, "UpdateIndicators") \
+    STAGE(UPDATE_DRAWING, "UpdateDrawing") \
+    STAGE(UPDATE_DISPLAY, "UpdateDisplay") \
+    STAGE(CONTROL_TASK, "ControlTask")
+
+typedef enum
+{
+#define PROFILE_ENUM(name, label) PROFILE_##name,
+    PROFILE_STAGES(PROFILE_ENUM)
+#undef PROFILE_ENUM
+    PROFILE_STAGE_COUNT
+} ProfileStage;
+
+#if PROFILING
+
+// Estatísticas de um estágio
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t histogram[PROFILE_BUCKETS];
+} ProfileStats;
+
+#define PROFILE_BEGIN(stage) uint64_t profileStart_##stage = HalTimeUs()
+#define PROFILE_END(stage) ProfileRecord(PROFILE_##stage, (uint32_t)(HalTimeUs() - profileStart_##stage))
+
+void ProfileRecord(ProfileStage stage, uint32_t us);
+void PrintProfile(void);
+void ResetProfile(void);
+
+#else
+
+#define PROFILE_BEGIN(stage) ((void)0)
+#define PROFILE_END(stage) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <General.h>
+
+#define SAMPLER_FIRST_INPUT 0     // Primeira entrada do round-robin (ADC0 = VRY)
+#define SAMPLER_CHANNELS 2        // Entradas amostradas: ADC0 (VRY) e ADC1 (VRX)
+#define SAMPLER_RATE_HZ 1000      // Amostras por segundo em cada entrada
+#define SAMPLER_RING_BITS 7       // Anel com 2^7 amostras (64 por entrada)
+#define SAMPLER_RING_SIZE (1u << SAMPLER_RING_BITS)
+
+#define SAMPLER_INPUT_MASK (((1u << SAMPLER_CHANNELS) - 1) << SAMPLER_FIRST_INPUT)
+#define ADC_CLOCK_HZ 48000000     // clk_adc, fixo em 48 MHz
+
+// Funções de amostragem contínua do ADC
+void InitSampler(void);
+uint16_t SamplerLatest(uint8_t input);
+uint16_t SamplerRead(uint8_t input, uint16_t *out, uint16_t max, uint16_t *cursor);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <General.h>
+
+#define SCHEDULER_MAX_TASKS 8     // Tarefas registráveis
+#define TASK_ON_EVENT 0           // Período das tarefas que só rodam quando sinalizadas
+
+// Tarefa cooperativa: roda até o fim e devolve o controle ao escalonador
+typedef void (*TaskFunction)(void);
+
+// Tarefa registrada e suas estatísticas
+typedef struct
+{
+    const char *name;
+    TaskFunction run;
+    uint32_t periodUs;        // Período em µs (TASK_ON_EVENT: roda somente após SignalTask)
+    uint8_t priority;         // Desempate entre prazos iguais (0 = mais prioritária)
+    volatile bool pending;    // Sinalizada e ainda não executada (tarefas por evento)
+    uint64_t deadline;        // Próxima ativação, em µs desde o boot (só o escalonador escreve)
+    uint32_t runs;            // Execuções
+    uint32_t overruns;        // Ativações perdidas por atraso ou execução longa
+    uint32_t maxRunUs;        // Maior duração de uma execução
+} Task;
+
+// Funções do escalonador
+int AddTask(const char *name, TaskFunction run, uint32_t periodUs, uint8_t priority);
+void SignalTask(int task);
+_Noreturn void RunScheduler(void);
+void PrintSchedulerStats(void);
+
+#endif
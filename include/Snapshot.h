@@ -0,0 +1,32 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <General.h>
+#include "Classifier.h"
+
+// Canal de instantâneo entre núcleos, sem trava, com um produtor e um consumidor.
+// O produtor nunca espera: grava o estado inteiro entre dois incrementos do
+// contador de sequência (ímpar = escrita em andamento). O consumidor copia o
+// estado e repete a cópia se a sequência mudou no meio, então sempre obtém um
+// instantâneo consistente, o mais recente publicado.
+
+// Estado que o núcleo de exibição precisa para desenhar uma tela
+typedef struct
+{
+    uint8_t zone;                      // Zona selecionada
+    uint8_t values[QUANTITY_COUNT];    // Valores da zona selecionada
+    bool zoneCritical;                 // Zona selecionada em estado crítico
+    uint8_t control;                   // Grandeza em ajuste (QUANTITY_COUNT: nenhuma)
+} DisplaySnapshot;
+
+typedef struct
+{
+    volatile uint32_t sequence;    // Par: estável; ímpar: escrita em andamento
+    DisplaySnapshot data;
+} SnapshotChannel;
+
+// Funções do canal
+void PublishSnapshot(SnapshotChannel *channel, const DisplaySnapshot *snapshot);
+bool ReadSnapshot(SnapshotChannel *channel, DisplaySnapshot *snapshot, uint32_t *lastSequence);
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef SSD1306_HPP
+#define SSD1306_HPP
+
+// Driver SSD1306 em C++17 com geometria definida em tempo de compilação.
+// Usa o mesmo formato de buffer do driver em C (modo de endereçamento vertical,
+// byte de controle na posição 0), mas com o buffer em um std::array estático:
+// não há alocação dinâmica e, com coordenadas constantes, o cálculo de índice
+// e o recorte são resolvidos pelo compilador.
+
+#include <array>
+#include <algorithm>
+#include <cstdint>
+
+#include "ssd1306.h"
+#include "Font.h"
+
+template <uint8_t W, uint8_t H>
+class Ssd1306
+{
+    static_assert(W > 0 && W <= 128, "SSD1306 suporta até 128 colunas");
+    static_assert(H == 32 || H == 64, "SSD1306 suporta 32 ou 64 linhas");
+
+public:
+    static constexpr uint8_t width = W;
+    static constexpr uint8_t height = H;
+    static constexpr uint8_t pages = H / 8;
+    static constexpr size_t bufsize = static_cast<size_t>(W) * pages + 1;
+
+    constexpr Ssd1306(uint8_t address, i2c_inst_t *i2c) : address_(address), i2c_(i2c), buffer_{} { buffer_[0] = 0x40; }
+
+    // Coordenada dentro da tela
+    static constexpr bool contains(int x, int y) { return x >= 0 && x < W && y >= 0 && y < H; }
+
+    // Posição no buffer do byte que contém o pixel (x, y)
+    static constexpr size_t index(uint8_t x, uint8_t y) { return 1 + static_cast<size_t>(x) * pages + (y >> 3); }
+
+    void config() const
+    {
+        static constexpr uint8_t sequence[] = {
+            SSD1306_CONTROL_CMD_STREAM,
+            SET_DISP | 0x00,
+            SET_MEM_ADDR, 0x01,
+            SET_DISP_START_LINE | 0x00,
+            SET_SEG_REMAP | 0x01,
+            SET_MUX_RATIO, H - 1,
+            SET_COM_OUT_DIR | 0x08,
+            SET_DISP_OFFSET, 0x00,
+            SET_COM_PIN_CFG, H == 64 ? 0x12 : 0x02,
+            SET_DISP_CLK_DIV, 0x80,
+            SET_PRECHARGE, 0xF1,
+            SET_VCOM_DESEL, 0x30,
+            SET_CONTRAST, 0xFF,
+            SET_ENTIRE_ON,
+            SET_NORM_INV,
+            SET_CHARGE_PUMP, 0x14,
+            SET_DISP | 0x01};
+        i2c_write_blocking(i2c_, address_, sequence, sizeof(sequence), false);
+    }
+
+    void send() const
+    {
+        const uint8_t window[] = {
+            SSD1306_CONTROL_CMD_STREAM,
+            SET_COL_ADDR, 0, W - 1,
+            SET_PAGE_ADDR, 0, pages - 1};
+        i2c_write_blocking(i2c_, address_, window, sizeof(window), false);
+        i2c_write_blocking(i2c_, address_, buffer_.data(), buffer_.size(), false);
+    }
+
+    void pixel(int x, int y, bool value)
+    {
+        if (!contains(x, y))
+            return;
+        uint8_t mask = 1u << (y & 7);
+        uint8_t &byte = buffer_[index(x, y)];
+        byte = value ? (byte | mask) : (byte & ~mask);
+    }
+
+    void fill(bool value) { std::fill(buffer_.begin() + 1, buffer_.end(), value ? 0xFF : 0x00); }
+
+    void hline(int x0, int x1, int y, bool value)
+    {
+        for (int x = std::max(x0, 0); x <= std::min(x1, W - 1); ++x)
+            pixel(x, y, value);
+    }
+
+    void vline(int x, int y0, int y1, bool value)
+    {
+        if (x < 0 || x >= W)
+            return;
+        y0 = std::max(y0, 0);
+        y1 = std::min(y1, H - 1);
+        for (int page = y0 >> 3; y0 <= y1 && page <= (y1 >> 3); ++page)
+        {
+            uint8_t mask = 0xFF;
+            if (page == (y0 >> 3))
+                mask &= 0xFF << (y0 & 7);
+            if (page == (y1 >> 3))
+                mask &= 0xFF >> (7 - (y1 & 7));
+            uint8_t &byte = buffer_[1 + static_cast<size_t>(x) * pages + page];
+            byte = value ? (byte | mask) : (byte & ~mask);
+        }
+    }
+
+    void rect(int top, int left, int w, int h, bool value, bool fill)
+    {
+        if (w <= 0 || h <= 0)
+            return;
+        if (fill)
+        {
+            for (int x = left; x < left + w; ++x)
+                vline(x, top, top + h - 1, value);
+            return;
+        }
+        hline(left, left + w - 1, top, value);
+        hline(left, left + w - 1, top + h - 1, value);
+        vline(left, top, top + h - 1, value);
+        vline(left + w - 1, top, top + h - 1, value);
+    }
+
+    void draw_char(char c, int x, int y)
+    {
+        uint8_t code = static_cast<uint8_t>(c);
+        if (code < FONT_FIRST_CHAR || code > FONT_LAST_CHAR || y < 0 || y >= H)
+            return;
+
+        const auto &glyph = font_[code - FONT_FIRST_CHAR];
+        uint8_t page = y >> 3;
+        uint8_t shift = y & 7;
+        for (int i = 0; i < FONT_WIDTH; ++i)
+        {
+            if (x + i < 0 || x + i >= W)
+                continue;
+            uint8_t *col = &buffer_[1 + static_cast<size_t>(x + i) * pages + page];
+            if (shift == 0)
+            {
+                col[0] = glyph[i];
+                continue;
+            }
+            uint8_t low_mask = 0xFF << shift;
+            col[0] = (col[0] & ~low_mask) | (glyph[i] << shift);
+            if (page + 1 < pages)
+                col[1] = (col[1] & low_mask) | (glyph[i] >> (8 - shift));
+        }
+    }
+
+    void draw_string(const char *str, int x, int y)
+    {
+        for (; *str && x < W; x += FONT_WIDTH)
+            draw_char(*str++, x, y);
+    }
+
+    const std::array<uint8_t, bufsize> &buffer() const { return buffer_; }
+
+private:
+#define SSD1306_HPP_GLYPH(c, b0, b1, b2, b3, b4, b5, b6, b7) {{b0, b1, b2, b3, b4, b5, b6, b7}},
+    static constexpr std::array<std::array<uint8_t, FONT_WIDTH>, FONT_GLYPH_COUNT> font_{{FONT_GLYPHS(SSD1306_HPP_GLYPH)}};
+#undef SSD1306_HPP_GLYPH
+
+    uint8_t address_;
+    i2c_inst_t *i2c_;
+    std::array<uint8_t, bufsize> buffer_;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <General.h>
+#include "Classifier.h"
+
+#define TELEMETRY_RING_BITS 6                       // Anel com 2^6 registros
+#define TELEMETRY_RING_SIZE (1u << TELEMETRY_RING_BITS)
+#define TELEMETRY_PERIOD_US 10000                   // Intervalo entre esvaziamentos do anel
+#define TELEMETRY_FRAMES_PER_DRAIN 1                // Pacotes enviados por esvaziamento
+
+// Pacote: SYNC0 SYNC1 tamanho registro checksum_lo checksum_hi
+// O checksum Fletcher-16 cobre o byte de tamanho e o registro.
+// tools/telemetry_decode.py converte o fluxo de pacotes em CSV.
+// Os pacotes dividem a serial com o console: o envio começa desligado
+// (EnableTelemetry)
+#define TELEMETRY_SYNC0 0xA5
+#define TELEMETRY_SYNC1 0x5A
+
+#define TELEMETRY_FLAG_SOUND_ALERT 0x01             // Alarme sonoro ativo
+#define TELEMETRY_FLAG_DROPPED 0x02                 // Registros anteriores descartados com o anel cheio
+
+// Amostra do estado do sistema, enviada byte a byte (little-endian)
+typedef struct __attribute__((packed))
+{
+    uint32_t timeUs;                  // µs desde o boot
+    uint8_t zone;                     // Zona selecionada
+    uint8_t values[QUANTITY_COUNT];   // Valores da zona selecionada
+    uint8_t control;                  // Grandeza em ajuste (QUANTITY_COUNT: nenhuma)
+    uint8_t severity;                 // Severidade combinada de todas as zonas
+    uint8_t flags;                    // TELEMETRY_FLAG_*
+} TelemetryRecord;
+
+// Funções de telemetria
+bool PushTelemetry(TelemetryRecord *record);
+void DrainTelemetry(void);
+void EnableTelemetry(bool enable);
+bool TelemetryEnabled(void);
+uint32_t DroppedTelemetry(void);
+
+#endif
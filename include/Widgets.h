@@ -0,0 +1,21 @@
+#ifndef WIDGETS_H
+#define WIDGETS_H
+
+#include "ssd1306.h"
+
+// Campo numérico retido: guarda o último conteúdo desenhado para só redesenhar o que mudou
+typedef struct
+{
+    uint8_t x, y;       // Canto superior esquerdo da área dos dígitos
+    uint8_t digits;     // Quantidade de dígitos reservados (valor alinhado à direita)
+    uint8_t markerX;    // Coluna do marcador de controle ativo
+    int16_t lastValue;  // Último valor desenhado (-1 força o redesenho)
+    int8_t lastMarker;  // Último estado do marcador (-1 força o redesenho)
+} NumericField;
+
+// Funções da camada de widgets
+void DrawLabel(ssd1306_t *ssd, const char *text, uint8_t x, uint8_t y);
+void InitNumericField(NumericField *field, uint8_t x, uint8_t y, uint8_t digits, uint8_t markerX);
+bool UpdateNumericField(ssd1306_t *ssd, NumericField *field, uint8_t value, bool marker);
+
+#endif
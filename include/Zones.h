@@ -0,0 +1,36 @@
+#ifndef ZONES_H
+#define ZONES_H
+
+#include <General.h>
+#include "Classifier.h"
+
+#ifndef ZONE_COUNT
+#define ZONE_COUNT 16                         // Canteiros controlados por esta placa
+#endif
+#define ZONE_WORDS ((ZONE_COUNT + 31) / 32)   // Palavras de 32 bits dos mapas de bits por zona
+
+// Estado de todas as zonas em estrutura de vetores: cada grandeza é um vetor
+// contíguo, percorrido de uma vez pela classificação em lote
+typedef struct
+{
+    uint8_t values[QUANTITY_COUNT][ZONE_COUNT];    // Valor atual de cada grandeza
+    uint8_t severity[QUANTITY_COUNT][ZONE_COUNT];  // Severidade de cada grandeza (memória da histerese)
+    uint32_t warningFlags[ZONE_WORDS];             // Bit por zona: em alerta ou crítica
+    uint32_t criticalFlags[ZONE_WORDS];            // Bit por zona: crítica
+} ZoneState;
+
+/**
+ * Lê o bit de uma zona em um mapa de bits
+ * @param flags Mapa de bits (warningFlags ou criticalFlags)
+ * @param zone Índice da zona
+ */
+static inline bool ZoneFlag(const uint32_t *flags, uint16_t zone)
+{
+    return (flags[zone >> 5] >> (zone & 31)) & 1;
+}
+
+// Funções das zonas
+void InitZones(ZoneState *zones, const uint8_t defaults[QUANTITY_COUNT]);
+Severity EvaluateZones(ZoneState *zones);
+
+#endif
@@ -1,9 +1,17 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
 
 #define WIDTH 128
 #define HEIGHT 64
+#define SSD1306_MAX_PAGES (HEIGHT / 8)
+
+// Byte de controle que antecede uma sequência de comandos em uma única transação (Co = 0, D/C# = 0)
+#define SSD1306_CONTROL_CMD_STREAM 0x00
 
 typedef enum {
   SET_CONTRAST = 0x81,
@@ -32,12 +40,35 @@ typedef struct {
   uint8_t *ram_buffer;
   size_t bufsize;
   uint8_t port_buffer[2];
+  // Rastreamento de páginas alteradas desde o último envio
+  uint8_t dirty_pages;                    // Bit n = página n alterada
+  uint8_t dirty_x0[SSD1306_MAX_PAGES];    // Primeira coluna alterada por página
+  uint8_t dirty_x1[SSD1306_MAX_PAGES];    // Última coluna alterada por página
+  uint8_t *gddram;                        // Cópia do conteúdo já enviado ao display
+  bool synced;                            // gddram reflete o display
+  // Envio assíncrono por DMA (ssd1306_init_dma)
+  int dma_channel;                        // Canal de DMA, -1 se não configurado
+  uint16_t *front_buffer;                 // Quadro em envio, no formato do registrador IC_DATA_CMD
+  size_t front_len;                       // Quantidade de palavras em front_buffer
+  uint8_t front_x0, front_x1;             // Colunas da janela do quadro em envio
+  uint8_t front_page0, front_page1;       // Páginas da janela do quadro em envio
 } ssd1306_t;
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *list, size_t len);
 void ssd1306_send_data(ssd1306_t *ssd);
+size_t ssd1306_flush(ssd1306_t *ssd);
+
+void ssd1306_init_dma(ssd1306_t *ssd);
+bool ssd1306_busy(ssd1306_t *ssd);
+bool ssd1306_swap_buffers(ssd1306_t *ssd);
+void ssd1306_send_data_async(ssd1306_t *ssd);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
@@ -46,4 +77,12 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
\ No newline at end of file
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+uint8_t ssd1306_draw_char_prop(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
+void ssd1306_draw_string_prop(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,16 @@
+#include <Checksum.h>
+
+/**
+ * Checksum Fletcher-16
+ * @param data Bytes cobertos
+ * @param len Quantidade de bytes
+ */
+uint16_t Fletcher16(const uint8_t *data, size_t len) {
+    uint16_t sum1 = 0, sum2 = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        sum1 = (sum1 + data[i]) % 255;
+        sum2 = (sum2 + sum1) % 255;
+    }
+    return (sum2 << 8) | sum1;
+}
@@ -0,0 +1,124 @@
+// Tabelas de severidade geradas em tempo de compilação a partir das faixas de
+// General.h, reconstruídas pelo mesmo código quando as faixas mudam em execução,
+// e classificação com histerese em tempo constante
+
+#include "Classifier.h"
+
+namespace classifier
+{
+    // Severidade de um valor para as faixas dadas: abaixo do mínimo normal ou
+    // acima do máximo de alerta é crítico; entre os máximos normal e de alerta, alerta
+    constexpr uint8_t severity(int value, int normalMin, int normalMax, int mediumMax)
+    {
+        return value < normalMin   ? SEVERITY_CRITICAL
+               : value <= normalMax ? SEVERITY_NORMAL
+               : value <= mediumMax ? SEVERITY_WARNING
+                                    : SEVERITY_CRITICAL;
+    }
+
+    // Tabela de uma grandeza: a saída pelo lado de cima usa os máximos
+    // estreitados pela histerese, e a saída por baixo, o mínimo alargado, então
+    // um valor na borda continua na severidade anterior
+    constexpr SeverityTable build_table(int normalMin, int normalMax, int mediumMax, int hysteresis)
+    {
+        SeverityTable table{};
+        for (int value = 0; value < 256; ++value)
+        {
+            uint8_t enter = severity(value, normalMin, normalMax, mediumMax) | (value < normalMin ? SEVERITY_LOW : 0);
+            uint8_t exit = severity(value, normalMin, normalMax - hysteresis, mediumMax - hysteresis);
+            uint8_t hold = value < normalMin + hysteresis ? SEVERITY_HOLD_LOW : 0;
+            table.entries[value] = enter | (exit << SEVERITY_EXIT_SHIFT) | hold;
+        }
+        return table;
+    }
+
+    // Faixas que produzem tabelas coerentes (os limites já cabem em uint8_t)
+    constexpr bool valid(int normalMin, int normalMax, int mediumMax, int hysteresis)
+    {
+        return normalMin + hysteresis <= normalMax - hysteresis && normalMax < mediumMax;
+    }
+
+    constexpr uint8_t min(uint8_t a, uint8_t b) { return a < b ? a : b; }
+    constexpr uint8_t max(uint8_t a, uint8_t b) { return a > b ? a : b; }
+}
+
+// Faixas inconsistentes são erro de compilação
+#define QUANTITY_CHECK(name, normalMin, normalMax, mediumMax, hysteresis)                          \
+    static_assert((normalMin) + (hysteresis) <= (normalMax) - (hysteresis),                         \
+                  #name ": a histerese não pode ser maior que metade da faixa normal");            \
+    static_assert((normalMax) < (mediumMax) && (mediumMax) < 256, #name ": faixas fora de ordem");
+CLASSIFIER_QUANTITIES(QUANTITY_CHECK)
+#undef QUANTITY_CHECK
+
+// Faixas e tabelas em RAM, iniciadas com os valores de General.h já calculados
+static SeverityBands severityBands[QUANTITY_COUNT] = {
+#define QUANTITY_BANDS(name, normalMin, normalMax, mediumMax, hysteresis) \
+    {normalMin, normalMax, mediumMax, hysteresis},
+    CLASSIFIER_QUANTITIES(QUANTITY_BANDS)
+#undef QUANTITY_BANDS
+};
+
+SeverityTable severityTables[QUANTITY_COUNT] = {
+#define QUANTITY_TABLE(name, normalMin, normalMax, mediumMax, hysteresis) \
+    classifier::build_table(normalMin, normalMax, mediumMax, hysteresis),
+    CLASSIFIER_QUANTITIES(QUANTITY_TABLE)
+#undef QUANTITY_TABLE
+};
+
+/**
+ * Lê as faixas atuais de uma grandeza
+ * @param quantity Grandeza
+ * @param bands Destino das faixas
+ */
+extern "C" void GetSeverityBands(Quantity quantity, SeverityBands *bands)
+{
+    *bands = severityBands[quantity];
+}
+
+/**
+ * Troca as faixas de uma grandeza e reconstrói sua tabela
+ * Deve ser chamada no mesmo contexto que ClassifyBatch
+ * @param quantity Grandeza
+ * @param bands Novas faixas
+ * @return false se as faixas são incoerentes (nada é alterado)
+ */
+extern "C" bool SetSeverityBands(Quantity quantity, const SeverityBands *bands)
+{
+    if (!classifier::valid(bands->normalMin, bands->normalMax, bands->mediumMax, bands->hysteresis))
+        return false;
+
+    severityBands[quantity] = *bands;
+    severityTables[quantity] = classifier::build_table(bands->normalMin, bands->normalMax, bands->mediumMax, bands->hysteresis);
+    return true;
+}
+
+/**
+ * Classifica uma grandeza em várias zonas de uma vez
+ * Uma consulta de tabela por valor, sem comparações com os limites
+ * @param quantity Grandeza classificada (seleciona a tabela)
+ * @param values Valor da grandeza em cada zona
+ * @param severity Severidade anterior de cada zona, atualizada com a nova
+ * @param combined Severidade combinada de cada zona, elevada para a nova se for maior
+ * @param count Quantidade de zonas
+ */
+extern "C" void ClassifyBatch(Quantity quantity, const uint8_t *values, uint8_t *severity, uint8_t *combined, uint16_t count)
+{
+    const uint8_t *entries = severityTables[quantity].entries;
+
+    for (uint16_t i = 0; i < count; ++i)
+    {
+        uint8_t entry = entries[values[i]];
+        uint8_t enter = entry & SEVERITY_ENTER_MASK;
+        uint8_t exit = (entry >> SEVERITY_EXIT_SHIFT) & SEVERITY_LEVEL_MASK;
+        uint8_t previous = severity[i];
+
+        // Abaixo do mínimo só sai depois de subir a histerese inteira. Pelo lado
+        // de cima piora imediatamente até a severidade de entrada e melhora só
+        // até a de saída; cair abaixo do mínimo (SEVERITY_LOW) sempre vence o max
+        uint8_t next = previous & SEVERITY_LOW
+                           ? (entry & SEVERITY_HOLD_LOW ? SEVERITY_CRITICAL | SEVERITY_LOW : enter)
+                           : classifier::max(enter, classifier::min(previous, exit));
+        severity[i] = next;
+        combined[i] = classifier::max(combined[i], next & SEVERITY_LEVEL_MASK);
+    }
+}
@@ -0,0 +1,128 @@
+#include <Conditioning.h>
+#include <string.h>
+
+// Média móvel: a amostra que sai da janela é subtraída da soma e a que entra é somada
+static void ProcessMovingAverage(FilterStage *stage, int32_t *samples, uint16_t count)
+{
+    MovingAverage *ma = &stage->state.movingAverage;
+    uint8_t mask = (1u << ma->shift) - 1;
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if (!ma->primed)
+        {
+            // Preenche a janela com a primeira amostra para não partir de zero
+            for (uint8_t k = 0; k <= mask; k++)
+                ma->history[k] = samples[i];
+            ma->sum = samples[i] << ma->shift;
+            ma->primed = true;
+        }
+
+        ma->sum += samples[i] - ma->history[ma->index];
+        ma->history[ma->index] = samples[i];
+        ma->index = (ma->index + 1) & mask;
+        samples[i] = ma->sum >> ma->shift;
+    }
+}
+
+// Mediana: ordena por inserção uma cópia da janela (no máximo 7 amostras)
+static void ProcessMedian(FilterStage *stage, int32_t *samples, uint16_t count)
+{
+    MedianFilter *median = &stage->state.median;
+    int32_t sorted[MEDIAN_MAX_SIZE];
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if (!median->primed)
+        {
+            for (uint8_t k = 0; k < median->size; k++)
+                median->history[k] = samples[i];
+            median->primed = true;
+        }
+
+        median->history[median->index] = samples[i];
+        median->index = (median->index + 1 == median->size) ? 0 : median->index + 1;
+
+        for (uint8_t k = 0; k < median->size; k++)
+        {
+            int32_t value = median->history[k];
+            int8_t j = k - 1;
+            while (j >= 0 && sorted[j] > value)
+            {
+                sorted[j + 1] = sorted[j];
+                j--;
+            }
+            sorted[j + 1] = value;
+        }
+        samples[i] = sorted[median->size >> 1];
+    }
+}
+
+// Média exponencial: y += (x - y) * 2^-shift, com o estado em Q16
+static void ProcessExpAverage(FilterStage *stage, int32_t *samples, uint16_t count)
+{
+    ExpAverage *exp = &stage->state.exp;
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        int32_t input = samples[i] << EMA_FRACTION_BITS;
+        if (!exp->primed)
+        {
+            exp->value = input;
+            exp->primed = true;
+        }
+
+        exp->value += (input - exp->value) >> exp->shift;
+        samples[i] = (exp->value + (1 << (EMA_FRACTION_BITS - 1))) >> EMA_FRACTION_BITS;
+    }
+}
+
+/**
+ * Configura um estágio de média móvel
+ * @param stage Estágio a ser configurado
+ * @param windowShift Janela de 2^windowShift amostras (limitada a MOVING_AVERAGE_MAX_SHIFT)
+ */
+void InitMovingAverage(FilterStage *stage, uint8_t windowShift)
+{
+    memset(stage, 0, sizeof(*stage));
+    stage->process = ProcessMovingAverage;
+    stage->state.movingAverage.shift = windowShift > MOVING_AVERAGE_MAX_SHIFT ? MOVING_AVERAGE_MAX_SHIFT : windowShift;
+}
+
+/**
+ * Configura um estágio de mediana
+ * @param stage Estágio a ser configurado
+ * @param size Tamanho da janela (ímpar, limitado a MEDIAN_MAX_SIZE)
+ */
+void InitMedianFilter(FilterStage *stage, uint8_t size)
+{
+    memset(stage, 0, sizeof(*stage));
+    stage->process = ProcessMedian;
+    if (size > MEDIAN_MAX_SIZE)
+        size = MEDIAN_MAX_SIZE;
+    stage->state.median.size = size | 1;
+}
+
+/**
+ * Configura um estágio de média exponencial
+ * @param stage Estágio a ser configurado
+ * @param alphaShift Fator de suavização alfa = 2^-alphaShift
+ */
+void InitExpAverage(FilterStage *stage, uint8_t alphaShift)
+{
+    memset(stage, 0, sizeof(*stage));
+    stage->process = ProcessExpAverage;
+    stage->state.exp.shift = alphaShift;
+}
+
+/**
+ * Aplica todos os estágios do pipeline, em ordem, a um bloco de amostras
+ * @param pipeline Pipeline de condicionamento
+ * @param samples Bloco de amostras, substituído pelas amostras condicionadas
+ * @param count Quantidade de amostras no bloco
+ */
+void PipelineProcess(FilterPipeline *pipeline, int32_t *samples, uint16_t count)
+{
+    for (uint8_t s = 0; s < pipeline->count; s++)
+        pipeline->stages[s].process(&pipeline->stages[s], samples, count);
+}
@@ -0,0 +1,152 @@
+#include <Console.h>
+#include <Hal.h>
+#include <string.h>
+
+static const ConsoleCommand *table = NULL;
+static uint8_t tableSize = 0;
+
+// Linha em recepção e estado de descarte de linhas longas demais
+static char line[CONSOLE_LINE_SIZE];
+static uint8_t lineLength = 0;
+static bool overflow = false;
+
+/**
+ * Registra a tabela de comandos da aplicação
+ * @param commands Tabela estática de comandos
+ * @param count Quantidade de comandos
+ */
+void InitConsole(const ConsoleCommand *commands, uint8_t count) {
+    table = commands;
+    tableSize = count;
+}
+
+/**
+ * Converte um número decimal (ou hexadecimal com 0x) sem sinal
+ * @param text Texto terminado em '\0'
+ * @param value Destino do número
+ * @return false se o texto não é um número válido de 32 bits
+ */
+bool ConsoleParseNumber(const char *text, uint32_t *value) {
+    uint32_t base = 10, result = 0;
+    
+    if (text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        base = 16;
+        text += 2;
+    }
+    if (!*text)
+        return false;
+    
+    for (; *text; text++) {
+        uint32_t digit;
+        if (*text >= '0' && *text <= '9')
+            digit = *text - '0';
+        else if (base == 16 && (*text | 0x20) >= 'a' && (*text | 0x20) <= 'f')
+            digit = (*text | 0x20) - 'a' + 10;
+        else
+            return false;
+        
+        if (result > (UINT32_MAX - digit) / base)
+            return false;
+        result = result * base + digit;
+    }
+    
+    *value = result;
+    return true;
+}
+
+/**
+ * Converte um número de um byte, como ConsoleParseNumber
+ * @param text Texto terminado em '\0'
+ * @param value Destino do número
+ * @return false se o texto não é um número ou passa de 255
+ */
+bool ConsoleParseByte(const char *text, uint8_t *value) {
+    uint32_t number;
+    if (!ConsoleParseNumber(text, &number) || number > UINT8_MAX)
+        return false;
+    
+    *value = number;
+    return true;
+}
+
+static void PrintHelp(void) {
+    printf("help\n");
+    for (int i = 0; i < tableSize; i++)
+        printf("%s %s\n", table[i].name, table[i].usage);
+}
+
+/**
+ * Divide a linha em palavras no próprio buffer e executa o comando
+ */
+static void Dispatch(void) {
+    char *argv[CONSOLE_MAX_ARGS];
+    int argc = 0;
+    char *cursor = line;
+    
+    while (*cursor) {
+        while (*cursor == ' ' || *cursor == '\t')
+            *cursor++ = '\0';
+        if (!*cursor)
+            break;
+        
+        if (argc == CONSOLE_MAX_ARGS) {
+            printf("erro: argumentos demais\n");
+            return;
+        }
+        argv[argc++] = cursor;
+        
+        while (*cursor && *cursor != ' ' && *cursor != '\t')
+            cursor++;
+    }
+    
+    if (argc == 0)
+        return;
+    
+    if (strcmp(argv[0], "help") == 0) {
+        PrintHelp();
+        return;
+    }
+    
+    for (int i = 0; i < tableSize; i++) {
+        if (strcmp(argv[0], table[i].name) == 0) {
+            table[i].run(argc, argv);
+            return;
+        }
+    }
+    printf("erro: comando desconhecido '%s' (help lista os comandos)\n", argv[0]);
+}
+
+/**
+ * Lê até CONSOLE_SLICE_CHARS caracteres disponíveis, sem esperar, e executa a
+ * linha quando ela termina. Feita para rodar como tarefa periódica
+ */
+void ConsoleTask(void) {
+    for (int i = 0; i < CONSOLE_SLICE_CHARS; i++) {
+        int c = HalConsoleRead();
+        if (c == HAL_NO_INPUT)
+            return;
+        
+        if (c == '\r' || c == '\n') {
+            line[lineLength] = '\0';
+            if (overflow)
+                printf("erro: linha com mais de %d caracteres\n", CONSOLE_LINE_SIZE - 1);
+            else
+                Dispatch();
+            
+            lineLength = 0;
+            overflow = false;
+            
+            // Uma linha por execução: o comando já consumiu o tempo da fatia
+            return;
+        }
+        
+        if (c == '\b' || c == 0x7F) {
+            if (lineLength)
+                lineLength--;
+        } else if (lineLength < CONSOLE_LINE_SIZE - 1) {
+            line[lineLength++] = c;
+        } else {
+            overflow = true;
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#include <Debounce.h>
+#include <InputEvents.h>
+#include <Hal.h>
+
+// O contador vertical de 2 bits conta de 3 até o estouro: quatro amostras
+_Static_assert(DEBOUNCE_SAMPLES == 4, "o contador vertical de 2 bits aceita a mudança na quarta amostra");
+
+static uint32_t buttonMask;
+
+// Estado aceito (1 = pressionado) e os dois bits de cada contador vertical
+static uint32_t pressed = 0;
+static uint32_t count0 = ~0u;
+static uint32_t count1 = ~0u;
+
+// Amostras seguidas com o botão pressionado, para o toque longo
+static uint16_t holdTicks[32];
+
+/**
+ * Amostra todos os botões e atualiza os contadores de uma vez
+ * Emite toque e soltura quando o estado aceito muda, e toque longo quando um
+ * botão completa LONG_PRESS_TICKS amostras pressionado
+ */
+static void SampleButtons(void) {
+    uint32_t now = HalTimeUs();
+    uint32_t raw = HalReadButtons(buttonMask);
+    
+    // Pinos cuja leitura difere do estado aceito contam; os demais reiniciam
+    uint32_t changed = pressed ^ raw;
+    count0 = ~(count0 & changed);
+    count1 = count0 ^ (count1 & changed);
+    
+    // Pinos cujo contador estourou trocam de estado
+    uint32_t toggled = changed & count0 & count1;
+    pressed ^= toggled;
+    
+    uint32_t pins = toggled | pressed;
+    while (pins) {
+        uint8_t pin = __builtin_ctz(pins);
+        uint32_t bit = 1u << pin;
+        pins &= pins - 1;
+        
+        if (toggled & bit) {
+            PushInputEvent(pin, (pressed & bit) ? INPUT_PRESS : INPUT_RELEASE, now);
+            holdTicks[pin] = 0;
+        } else if (holdTicks[pin] < LONG_PRESS_TICKS && ++holdTicks[pin] == LONG_PRESS_TICKS) {
+            PushInputEvent(pin, INPUT_LONG_PRESS, now);
+        }
+    }
+}
+
+/**
+ * Inicia a amostragem periódica dos botões
+ * Os pinos já devem estar configurados como entrada com pull-up
+ * @param pinMask Máscara dos pinos dos botões (bit n = GPIO n)
+ */
+void InitDebounce(uint32_t pinMask) {
+    buttonMask = pinMask;
+    HalStartTicker(DEBOUNCE_SAMPLE_US, SampleButtons);
+}
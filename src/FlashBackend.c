@@ -0,0 +1,48 @@
+#include <FlashBackend.h>
+#include <string.h>
+#include "pico/flash.h"
+#include "History.h"
+
+#define FLASH_REGION_OFFSET (PICO_FLASH_SIZE_BYTES - HISTORY_REGION_SIZE)
+#define FLASH_SAFE_TIMEOUT_MS 100    // Espera máxima pela pausa do outro núcleo
+
+// Parâmetros de uma operação executada com o outro núcleo pausado
+typedef struct
+{
+    uint32_t offset;
+    const void *data;
+    size_t len;
+} FlashOperation;
+
+static void ReadRegion(uint32_t offset, void *data, size_t len) {
+    memcpy(data, (const void *)(uintptr_t)(XIP_BASE + FLASH_REGION_OFFSET + offset), len);
+}
+
+static void DoErase(void *param) {
+    const FlashOperation *op = param;
+    flash_range_erase(FLASH_REGION_OFFSET + op->offset, op->len);
+}
+
+static void DoProgram(void *param) {
+    const FlashOperation *op = param;
+    flash_range_program(FLASH_REGION_OFFSET + op->offset, op->data, op->len);
+}
+
+// A flash fica fora do XIP durante a operação: flash_safe_execute desativa as
+// interrupções e pausa o outro núcleo até o fim
+static bool EraseRegion(uint32_t offset, size_t len) {
+    FlashOperation op = { offset, NULL, len };
+    return flash_safe_execute(DoErase, &op, FLASH_SAFE_TIMEOUT_MS) == PICO_OK;
+}
+
+static bool ProgramRegion(uint32_t offset, const void *data, size_t len) {
+    FlashOperation op = { offset, data, len };
+    return flash_safe_execute(DoProgram, &op, FLASH_SAFE_TIMEOUT_MS) == PICO_OK;
+}
+
+const FlashBackend picoFlash = {
+    .size = HISTORY_REGION_SIZE,
+    .read = ReadRegion,
+    .erase = EraseRegion,
+    .program = ProgramRegion,
+};
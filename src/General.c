@@ -7,7 +7,7 @@ refs InitConf()
     pio.ref = pio0;
     stdio_init_all();
     if (set_sys_clock_khz(128000, false))
-        printf("Clock configurado para %ld\n", clock_get_hz(clk_sys));
+        printf("Clock configurado para %lu\n", (unsigned long)clock_get_hz(clk_sys));
     pio.offset = pio_add_program(pio.ref, &pio_matrix_program);
     pio.stateMachine = pio_claim_unused_sm(pio.ref, true);
     return pio;
@@ -0,0 +1,216 @@
+#include <General.h>
+#include <Hal.h>
+#include <Sampler.h>
+#include <MatrixDma.h>
+
+#if DUAL_CORE
+#include "pico/multicore.h"
+#include "pico/flash.h"
+#endif
+
+// O leitor de cada eixo guarda uma volta inteira do anel do ADC
+_Static_assert(HAL_ADC_BLOCK == SAMPLER_RING_SIZE / SAMPLER_CHANNELS, "HAL_ADC_BLOCK deve ser a parte de uma entrada no anel do ADC");
+
+// Temporizadores do SDK e a tarefa de cada um (NULL: temporizador livre)
+static repeating_timer_t timers[HAL_MAX_TICKERS];
+static HalTick ticks[HAL_MAX_TICKERS];
+
+/**
+ * Inicializa os periféricos da placa: relógio e stdio, PIO e DMA da matriz,
+ * botões com pull-up, LEDs indicadores, amostragem contínua do ADC e o PWM
+ * do buzzer. O display é inicializado por HalDisplayInit, no núcleo que o usa
+ */
+void HalInit(void) {
+    InitMatrixDMA(InitPIO());
+    
+    SetInput(BUTTON_A);
+    SetInput(BUTTON_B);
+    SetInput(JOYSTICK_BUTTON);
+    SetOutput(RED_LED);
+    SetOutput(GREEN_LED);
+    
+    InitSampler();
+    pwm_init_gpio(BUZZER_A);
+}
+
+#if DUAL_CORE
+static void (*core1Entry)(void);
+
+// Primeira função do núcleo 1: aceita ser pausado durante a gravação da flash
+static void Core1Start(void) {
+    flash_safe_execute_core_init();
+    core1Entry();
+}
+
+/**
+ * Inicia o núcleo 1 e espera até que ele aceite ser pausado, pois a flash só
+ * pode ser gravada a partir daí
+ * @param entry Laço do núcleo 1
+ */
+void HalLaunchCore1(void (*entry)(void)) {
+    core1Entry = entry;
+    multicore_launch_core1(Core1Start);
+    while (!multicore_lockout_victim_is_initialized(1))
+        tight_loop_contents();
+}
+#endif
+
+/**
+ * Tempo desde o boot, em µs
+ */
+uint64_t HalTimeUs(void) {
+    return time_us_64();
+}
+
+/**
+ * Dorme em WFE até o prazo ou até um evento (interrupção ou HalWake)
+ * Pode retornar antes do prazo: quem chama verifica o relógio de novo
+ * @param deadlineUs Prazo em µs desde o boot, ou UINT64_MAX para esperar só por evento
+ */
+void HalSleepUntil(uint64_t deadlineUs) {
+    best_effort_wfe_or_timeout(deadlineUs == UINT64_MAX ? at_the_end_of_time : from_us_since_boot(deadlineUs));
+}
+
+/**
+ * Acorda um núcleo parado em HalSleepUntil. Pode ser chamada de interrupções
+ */
+void HalWake(void) {
+    __sev();
+}
+
+static bool RunTicker(repeating_timer_t *timer) {
+    const HalTick *tick = timer->user_data;
+    (*tick)();
+    return true;
+}
+
+/**
+ * Chama uma tarefa a cada período, em contexto de interrupção
+ * @param periodUs Período entre o início de chamadas seguidas
+ * @param tick Tarefa chamada
+ * @return Identificador para HalStopTicker, ou -1 se todos os temporizadores estão em uso
+ */
+int HalStartTicker(uint32_t periodUs, HalTick tick) {
+    for (int i = 0; i < HAL_MAX_TICKERS; i++) {
+        if (ticks[i])
+            continue;
+        
+        // Período negativo: medido entre inícios, sem acumular a duração da tarefa
+        ticks[i] = tick;
+        if (add_repeating_timer_us(-(int64_t)periodUs, RunTicker, &ticks[i], &timers[i]))
+            return i;
+        
+        ticks[i] = NULL;
+        break;
+    }
+    return -1;
+}
+
+/**
+ * Cancela um temporizador e o libera para outro HalStartTicker
+ * @param ticker Identificador retornado por HalStartTicker (-1 é ignorado)
+ */
+void HalStopTicker(int ticker) {
+    if (ticker < 0 || ticker >= HAL_MAX_TICKERS || !ticks[ticker])
+        return;
+    
+    cancel_repeating_timer(&timers[ticker]);
+    ticks[ticker] = NULL;
+}
+
+/**
+ * Lê os botões de uma vez
+ * Os botões têm pull-up: nível baixo é pressionado
+ * @param pinMask Máscara dos pinos dos botões (bit n = GPIO n)
+ * @return Máscara dos botões pressionados
+ */
+uint32_t HalReadButtons(uint32_t pinMask) {
+    return ~gpio_get_all() & pinMask;
+}
+
+void HalSetLed(uint8_t gpio, bool on) {
+    gpio_put(gpio, on);
+}
+
+/**
+ * @param level Nível do PWM do buzzer, de 0 (desligado) a PWM_WRAP
+ */
+void HalSetBuzzer(uint16_t level) {
+    pwm_set_gpio_level(BUZZER_A, level);
+}
+
+/**
+ * Copia as amostras de uma entrada do ADC produzidas desde a última leitura,
+ * sem bloquear (ver SamplerRead)
+ * @param input Número da entrada do ADC
+ * @param out Destino das amostras, da mais antiga para a mais recente
+ * @param max Capacidade de out
+ * @param cursor Posição da última leitura (mantida pelo chamador, começa em 0)
+ * @return Quantidade de amostras copiadas
+ */
+uint16_t HalAdcRead(uint8_t input, uint16_t *out, uint16_t max, uint16_t *cursor) {
+    return SamplerRead(input, out, max, cursor);
+}
+
+/**
+ * Coloca um quadro da matriz na fila de envio por DMA (ver MatrixSubmit)
+ * @param frame Quadro com NUM_PIXELS palavras GRB, na ordem de envio
+ * @return false se a fila está cheia
+ */
+bool HalMatrixSubmit(const uint32_t *frame) {
+    return MatrixSubmit(frame);
+}
+
+/**
+ * Inicializa o I2C a 400 kHz, o display e o envio por DMA
+ * O primeiro HalDisplaySend envia o quadro completo
+ * @param ssd Estrutura do display, com o framebuffer onde a aplicação desenha
+ */
+void HalDisplayInit(ssd1306_t *ssd) {
+    i2c_init(I2C_PORT, 400 * 1000);
+    
+    // Configuração dos pinos SDA e SCL
+    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_SDA);
+    gpio_pull_up(I2C_SCL);
+    
+    ssd1306_init(ssd, WIDTH, HEIGHT, false, ADRESS, I2C_PORT);
+    ssd1306_config(ssd);
+    ssd1306_init_dma(ssd);
+}
+
+/**
+ * Envia as regiões alteradas do display por DMA, sem bloquear quem chamou
+ * Se o quadro anterior ainda está em envio, as alterações ficam para a próxima chamada
+ * @param ssd Display inicializado por HalDisplayInit
+ */
+void HalDisplaySend(ssd1306_t *ssd) {
+    if (ssd1306_swap_buffers(ssd))
+        ssd1306_send_data_async(ssd);
+}
+
+/**
+ * Região da flash reservada ao histórico, no fim da flash da placa
+ */
+const FlashBackend *HalHistoryFlash(void) {
+    return &picoFlash;
+}
+
+/**
+ * Lê um caractere da stdio (USB ou UART), sem esperar
+ * @return Caractere, ou HAL_NO_INPUT se nada chegou
+ */
+int HalConsoleRead(void) {
+    int c = getchar_timeout_us(0);
+    return c == PICO_ERROR_TIMEOUT ? HAL_NO_INPUT : c;
+}
+
+/**
+ * Escreve bytes na stdio sem tradução de fim de linha (dados binários)
+ * @param data Bytes a escrever
+ * @param len Quantidade de bytes
+ */
+void HalSerialWrite(const void *data, size_t len) {
+    stdio_put_string((const char *)data, len, false, false);
+}
@@ -0,0 +1,439 @@
+#include <History.h>
+#include <Checksum.h>
+#include <stddef.h>
+#include <string.h>
+
+_Static_assert(HISTORY_MAX_RECORD <= HISTORY_CHUNK_PAYLOAD && HISTORY_MAX_RESTART <= HISTORY_CHUNK_PAYLOAD, "um registro completo precisa caber em um trecho");
+_Static_assert(HISTORY_CHUNK_PAYLOAD < 0xFF, "tamanho 0xFF marca a área apagada");
+_Static_assert(sizeof(HistorySegmentHeader) <= FLASH_PAGE_SIZE, "o cabeçalho deve caber na página 0");
+
+static const FlashBackend *flash = NULL;
+static bool ready = false;        // Segmento aberto; false desativa a gravação
+
+// Segmento aberto para escrita
+static uint16_t segment;          // Setor do segmento
+static uint16_t page;             // Página em preenchimento (1 a HISTORY_PAGES - 1)
+static uint16_t pageFree;         // Início da parte apagada da página
+static uint32_t sequence;         // Sequência do segmento
+static uint32_t boot;             // Inicialização atual
+
+// Trecho em preenchimento: registros inteiros ainda não gravados
+static uint8_t chunk[HISTORY_CHUNK_PAYLOAD];
+static uint16_t chunkUsed = 0;
+static uint16_t uncommitted = 0;  // Registros no trecho
+
+// Último registro, base da codificação do próximo
+static uint8_t baseline[HISTORY_VALUE_COUNT];
+static uint32_t lastS;
+
+// Buffers de codificação, de uma página e da leitura de um segmento
+static uint8_t record[HISTORY_MAX_RECORD];
+static uint8_t pageBuffer[FLASH_PAGE_SIZE];
+static uint8_t segmentData[HISTORY_SEGMENT_PAYLOAD];
+
+// Varint: 7 bits por byte, bit 7 indica que há mais bytes
+static uint8_t *PutVarint(uint8_t *out, uint32_t value) {
+    while (value >= 0x80) {
+        *out++ = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    *out++ = value;
+    return out;
+}
+
+static bool GetVarint(const uint8_t **in, const uint8_t *end, uint32_t *value) {
+    uint32_t result = 0;
+
+    for (int shift = 0; shift < 35 && *in < end; shift += 7) {
+        uint8_t byte = *(*in)++;
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Zigzag: diferenças pequenas, positivas ou negativas, viram varints curtos
+static inline uint32_t Zigzag(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static inline int32_t Unzigzag(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static bool ReadHeader(uint16_t sector, HistorySegmentHeader *header) {
+    flash->read(sector * FLASH_SECTOR_SIZE, header, sizeof(*header));
+    return header->magic == HISTORY_MAGIC &&
+           header->checksum == Fletcher16((const uint8_t *)header, offsetof(HistorySegmentHeader, checksum));
+}
+
+/**
+ * Lê os trechos válidos de uma página
+ * @param address Endereço da página na região
+ * @param data Recebe os registros dos trechos, em ordem
+ * @param free Recebe o início da parte apagada, ou FLASH_PAGE_SIZE se a página
+ *             não aceita mais trechos (cheia ou com um trecho corrompido)
+ * @return Bytes de registros lidos
+ */
+static size_t ReadPage(uint32_t address, uint8_t *data, uint16_t *free) {
+    size_t len = 0;
+    uint32_t offset = 0;
+
+    flash->read(address, pageBuffer, FLASH_PAGE_SIZE);
+    *free = FLASH_PAGE_SIZE;
+
+    while (offset + HISTORY_CHUNK_HEADER < FLASH_PAGE_SIZE) {
+        uint8_t used = pageBuffer[offset];
+
+        // Fim dos trechos: só aceita mais se o resto da página está apagado
+        // (uma queda de energia pode ter gravado parte de um trecho)
+        if (used == 0xFF) {
+            uint32_t i = offset;
+            while (i < FLASH_PAGE_SIZE && pageBuffer[i] == 0xFF)
+                i++;
+            if (i == FLASH_PAGE_SIZE)
+                *free = offset;
+            break;
+        }
+
+        uint16_t checksum = pageBuffer[offset + 1] | (pageBuffer[offset + 2] << 8);
+        const uint8_t *payload = pageBuffer + offset + HISTORY_CHUNK_HEADER;
+        if (used == 0 || offset + HISTORY_CHUNK_HEADER + used > FLASH_PAGE_SIZE ||
+            (Fletcher16(payload, used) ^ used) != checksum)
+            break;
+
+        memcpy(data + len, payload, used);
+        len += used;
+        offset += HISTORY_CHUNK_HEADER + used;
+    }
+    return len;
+}
+
+/**
+ * Decodifica os registros de um segmento, a partir de zero
+ * Um registro incompleto no fim é descartado
+ * @param visit Função chamada para cada registro, ou NULL
+ * @return Inicialização do último registro ou marcador de reinício
+ */
+static uint32_t DecodeSegment(const uint8_t *in, const uint8_t *end, const HistorySegmentHeader *header,
+                              HistoryVisitor visit, void *context) {
+    uint8_t values[HISTORY_VALUE_COUNT];
+    uint32_t timeS = header->startS;
+    uint32_t segmentBoot = header->boot;
+    memset(values, 0, sizeof(values));
+
+    while (in < end) {
+        uint32_t delta, changed, index, diff;
+        if (!GetVarint(&in, end, &delta) || !GetVarint(&in, end, &changed))
+            break;
+
+        // Reinício: nova base de tempo e valores a partir de zero
+        if (changed == HISTORY_RESTART) {
+            if (!GetVarint(&in, end, &segmentBoot) || !GetVarint(&in, end, &timeS))
+                break;
+            memset(values, 0, sizeof(values));
+            continue;
+        }
+
+        bool complete = true;
+        for (uint32_t i = 0; i < changed && complete; i++) {
+            complete = GetVarint(&in, end, &index) && GetVarint(&in, end, &diff) && index < HISTORY_VALUE_COUNT;
+            if (complete)
+                values[index] += Unzigzag(diff);
+        }
+        if (!complete)
+            break;
+
+        timeS += delta;
+        if (visit)
+            visit(context, segmentBoot, timeS, values);
+    }
+    return segmentBoot;
+}
+
+/**
+ * Abre o próximo segmento do rodízio: apaga o setor e grava o cabeçalho
+ * O próximo registro é codificado em relação a zero. Se a flash falhar, o
+ * segmento fica como cheio e o próximo acréscimo tenta abrir o seguinte
+ */
+static bool OpenSegment(uint32_t nowS) {
+    segment = (segment + 1) % HISTORY_SECTORS;
+    sequence++;
+    page = HISTORY_PAGES;
+    chunkUsed = 0;
+    uncommitted = 0;
+
+    HistorySegmentHeader header = {
+        .magic = HISTORY_MAGIC,
+        .sequence = sequence,
+        .boot = boot,
+        .startS = nowS,
+        .zoneCount = ZONE_COUNT,
+        .quantityCount = QUANTITY_COUNT,
+    };
+    header.checksum = Fletcher16((const uint8_t *)&header, offsetof(HistorySegmentHeader, checksum));
+
+    memset(pageBuffer, 0xFF, sizeof(pageBuffer));
+    memcpy(pageBuffer, &header, sizeof(header));
+
+    uint32_t offset = segment * FLASH_SECTOR_SIZE;
+    if (!flash->erase(offset, FLASH_SECTOR_SIZE) || !flash->program(offset, pageBuffer, FLASH_PAGE_SIZE))
+        return false;
+
+    page = 1;
+    pageFree = 0;
+    memset(baseline, 0, sizeof(baseline));
+    lastS = nowS;
+    return true;
+}
+
+/**
+ * Grava o trecho em preenchimento na parte apagada da página; o resto da
+ * página vai como 0xFF e não muda. Se a gravação falhar, o segmento fica como
+ * cheio: os registros seguintes seriam relativos a um trecho perdido
+ */
+static bool CommitChunk(void) {
+    if (chunkUsed == 0)
+        return true;
+
+    // Nunca grava além do segmento: a página seguinte seria o cabeçalho de outro
+    if (page >= HISTORY_PAGES) {
+        chunkUsed = 0;
+        uncommitted = 0;
+        return false;
+    }
+
+    uint16_t checksum = Fletcher16(chunk, chunkUsed) ^ chunkUsed;
+    memset(pageBuffer, 0xFF, sizeof(pageBuffer));
+    pageBuffer[pageFree] = chunkUsed;
+    pageBuffer[pageFree + 1] = checksum & 0xFF;
+    pageBuffer[pageFree + 2] = checksum >> 8;
+    memcpy(pageBuffer + pageFree + HISTORY_CHUNK_HEADER, chunk, chunkUsed);
+
+    bool ok = flash->program(segment * FLASH_SECTOR_SIZE + page * FLASH_PAGE_SIZE, pageBuffer, FLASH_PAGE_SIZE);
+    pageFree += HISTORY_CHUNK_HEADER + chunkUsed;
+    chunkUsed = 0;
+    uncommitted = 0;
+    if (!ok)
+        page = HISTORY_PAGES;
+    return ok;
+}
+
+/**
+ * Grava o trecho pendente e passa para a próxima página
+ */
+static bool NextPage(void) {
+    bool ok = CommitChunk();
+    if (page < HISTORY_PAGES)
+        page++;
+    pageFree = 0;
+    return ok;
+}
+
+// Espaço para registros no trecho em preenchimento, até o fim da página
+static size_t ChunkSpace(void) {
+    if (page >= HISTORY_PAGES || (uint32_t)pageFree + HISTORY_CHUNK_HEADER >= FLASH_PAGE_SIZE)
+        return 0;
+    return FLASH_PAGE_SIZE - pageFree - HISTORY_CHUNK_HEADER - chunkUsed;
+}
+
+/**
+ * Codifica os valores em relação ao registro anterior
+ * @return Tamanho do registro em bytes
+ */
+static size_t EncodeRecord(const uint8_t *values, uint32_t nowS) {
+    uint32_t changed = 0;
+    for (int i = 0; i < HISTORY_VALUE_COUNT; i++)
+        changed += values[i] != baseline[i];
+
+    uint8_t *out = PutVarint(record, nowS - lastS);
+    out = PutVarint(out, changed);
+
+    for (int i = 0; i < HISTORY_VALUE_COUNT && changed; i++) {
+        if (values[i] == baseline[i])
+            continue;
+        out = PutVarint(out, i);
+        out = PutVarint(out, Zigzag((int32_t)values[i] - baseline[i]));
+        changed--;
+    }
+    return out - record;
+}
+
+/**
+ * Continua a escrita no segmento mais recente, na primeira área apagada
+ * depois dos trechos válidos, e põe no trecho o marcador de reinício
+ * @return false se o segmento não aceita mais trechos
+ */
+static bool ResumeSegment(const HistorySegmentHeader *header, uint32_t nowS) {
+    if (header->zoneCount != ZONE_COUNT || header->quantityCount != QUANTITY_COUNT)
+        return false;
+
+    uint32_t base = segment * FLASH_SECTOR_SIZE;
+    size_t len = 0;
+    page = 1;
+    pageFree = 0;
+
+    // Continua na última página usada; uma página deixada para trás com a
+    // ponta apagada (o registro seguinte não cabia) não é reaproveitada
+    for (uint16_t p = 1; p < HISTORY_PAGES; p++) {
+        uint16_t free;
+        len += ReadPage(base + p * FLASH_PAGE_SIZE, segmentData + len, &free);
+        if (free > 0) {
+            page = p;
+            pageFree = free;
+        }
+    }
+
+    // A última inicialização pode estar só em um marcador deste segmento
+    uint32_t lastBoot = DecodeSegment(segmentData, segmentData + len, header, NULL, NULL);
+    if ((int32_t)(lastBoot + 1 - boot) > 0)
+        boot = lastBoot + 1;
+
+    chunkUsed = 0;
+    uncommitted = 0;
+    // O marcador pode ir sozinho no trecho: um registro que não couber depois
+    // dele passa para a próxima página
+    if (ChunkSpace() < HISTORY_MAX_RESTART) {
+        page++;
+        pageFree = 0;
+    }
+    if (page >= HISTORY_PAGES)
+        return false;
+
+    uint8_t *out = PutVarint(chunk, 0);
+    out = PutVarint(out, HISTORY_RESTART);
+    out = PutVarint(out, boot);
+    out = PutVarint(out, nowS);
+    chunkUsed = out - chunk;
+
+    memset(baseline, 0, sizeof(baseline));
+    lastS = nowS;
+    return true;
+}
+
+/**
+ * Localiza o segmento mais recente lendo os cabeçalhos e continua nele; um
+ * segmento novo só é aberto se ele estiver cheio ou for de outro formato
+ * @param backend Região de flash do histórico
+ * @param nowS Segundos desde o boot
+ * @return false se a flash não pôde ser gravada (o histórico fica desativado)
+ */
+bool InitHistory(const FlashBackend *backend, uint32_t nowS) {
+    flash = backend;
+    segment = HISTORY_SECTORS - 1;
+    sequence = 0;
+    boot = 0;
+
+    bool found = false;
+    HistorySegmentHeader head = { 0 };
+    for (uint16_t sector = 0; sector < HISTORY_SECTORS; sector++) {
+        HistorySegmentHeader header;
+        if (!ReadHeader(sector, &header))
+            continue;
+
+        // Comparação por diferença: continua correta quando a sequência dá a volta
+        if (!found || (int32_t)(header.sequence - sequence) > 0) {
+            found = true;
+            segment = sector;
+            sequence = header.sequence;
+            boot = header.boot + 1;
+            head = header;
+        }
+    }
+
+    ready = (found && ResumeSegment(&head, nowS)) || OpenSegment(nowS);
+    return ready;
+}
+
+/**
+ * Acrescenta um registro. A flash só é gravada quando a página enche ou a cada
+ * HISTORY_COMMIT_RECORDS registros
+ * @param values Valores na ordem de ZoneState.values (HISTORY_VALUE_COUNT bytes)
+ * @param nowS Segundos desde o boot
+ * @return false se a gravação na flash falhou
+ */
+bool AppendHistory(const uint8_t *values, uint32_t nowS) {
+    if (!ready)
+        return false;
+
+    bool ok = true;
+    size_t len = EncodeRecord(values, nowS);
+
+    // Registros não atravessam trechos: sem espaço na página, grava o trecho
+    // e passa para a próxima. Sem páginas no segmento, abre o próximo e
+    // recodifica a partir de zero. Se a troca falhar o registro é descartado;
+    // seguir adiante gravaria páginas fora do segmento
+    if (len > ChunkSpace()) {
+        ok = NextPage();
+        if (page >= HISTORY_PAGES) {
+            if (!OpenSegment(nowS))
+                return false;
+            len = EncodeRecord(values, nowS);
+        }
+    }
+
+    memcpy(chunk + chunkUsed, record, len);
+    chunkUsed += len;
+    memcpy(baseline, values, sizeof(baseline));
+    lastS = nowS;
+
+    if (++uncommitted >= HISTORY_COMMIT_RECORDS)
+        ok &= CommitChunk();
+    return ok;
+}
+
+/**
+ * Grava os registros ainda na RAM
+ */
+bool CommitHistory(void) {
+    return ready && CommitChunk();
+}
+
+/**
+ * Decodifica os registros gravados, do segmento mais antigo ao mais recente
+ * Em cada página valem os trechos até o primeiro não gravado ou corrompido
+ * @param visit Função chamada para cada registro
+ * @param context Repassado a visit
+ */
+void ReplayHistory(HistoryVisitor visit, void *context) {
+    uint16_t order[HISTORY_SECTORS];
+    uint32_t sequences[HISTORY_SECTORS];
+    int count = 0;
+
+    if (!flash)
+        return;
+
+    // Segmentos válidos do formato atual, ordenados por sequência
+    for (uint16_t sector = 0; sector < HISTORY_SECTORS; sector++) {
+        HistorySegmentHeader header;
+        if (!ReadHeader(sector, &header) || header.zoneCount != ZONE_COUNT || header.quantityCount != QUANTITY_COUNT)
+            continue;
+
+        int i = count++;
+        for (; i > 0 && (int32_t)(sequences[i - 1] - header.sequence) > 0; i--) {
+            order[i] = order[i - 1];
+            sequences[i] = sequences[i - 1];
+        }
+        order[i] = sector;
+        sequences[i] = header.sequence;
+    }
+
+    for (int s = 0; s < count; s++) {
+        uint32_t base = order[s] * FLASH_SECTOR_SIZE;
+        HistorySegmentHeader header;
+        ReadHeader(order[s], &header);
+
+        // Uma página com trecho corrompido (queda de energia) é seguida por um
+        // marcador de reinício, então as páginas seguintes ainda valem
+        size_t len = 0;
+        for (uint16_t p = 1; p < HISTORY_PAGES; p++) {
+            uint16_t free;
+            len += ReadPage(base + p * FLASH_PAGE_SIZE, segmentData + len, &free);
+        }
+
+        DecodeSegment(segmentData, segmentData + len, &header, visit, context);
+    }
+}
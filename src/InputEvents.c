@@ -0,0 +1,57 @@
+#include <InputEvents.h>
+
+static InputEvent queue[INPUT_QUEUE_SIZE];
+static volatile uint32_t head = 0;       // Próxima escrita (somente o produtor altera)
+static volatile uint32_t tail = 0;       // Próxima leitura (somente o consumidor altera)
+static volatile uint32_t dropped = 0;    // Eventos descartados com a fila cheia
+
+/**
+ * Enfileira um evento. Tempo constante, próprio para interrupções
+ * @param gpio Pino de origem
+ * @param type Tipo do evento
+ * @param timeUs Instante do evento em µs desde o boot
+ * @return false se a fila estava cheia e o evento foi descartado
+ */
+bool PushInputEvent(uint8_t gpio, InputEventType type, uint32_t timeUs) {
+    uint32_t position = head;
+    
+    if (position - tail == INPUT_QUEUE_SIZE) {
+        dropped++;
+        return false;
+    }
+    
+    InputEvent *event = &queue[position & (INPUT_QUEUE_SIZE - 1)];
+    event->timeUs = timeUs;
+    event->gpio = gpio;
+    event->type = type;
+    
+    // O evento fica completo na memória antes de o consumidor ver o novo índice
+    __dmb();
+    head = position + 1;
+    return true;
+}
+
+/**
+ * Retira o evento mais antigo da fila
+ * @param event Destino do evento
+ * @return false se a fila estava vazia
+ */
+bool PopInputEvent(InputEvent *event) {
+    uint32_t position = tail;
+    
+    if (position == head)
+        return false;
+    
+    __dmb();
+    *event = queue[position & (INPUT_QUEUE_SIZE - 1)];
+    __dmb();
+    tail = position + 1;
+    return true;
+}
+
+/**
+ * @return Quantidade de eventos descartados por falta de espaço desde o boot
+ */
+uint32_t DroppedInputEvents(void) {
+    return dropped;
+}
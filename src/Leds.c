@@ -1,107 +1,253 @@
 #include <Leds.h>
+#include <Patterns.h>
+#include <Hal.h>
+#include <string.h>
+ 
+ // Tabela de correção de gama já multiplicada pelo brilho global
+ static uint8_t colorLut[256];
+ 
+ /**
+  * Recalcula a tabela de cores para um novo brilho global
+  * O cálculo em ponto flutuante acontece só aqui, nunca ao montar os quadros
+  * 
+  * @param brightness Brilho global de 0 (apagado) a 255 (máximo)
+  */
+ void SetMatrixBrightness(uint8_t brightness) {
+     for (int i = 0; i < 256; i++)
+     {
+         float level = powf(i / 255.0f, MATRIX_GAMMA) * brightness;
+         colorLut[i] = (uint8_t)(level + 0.5f);
+     }
+ }
  
  /**
   * Converte uma cor RGB para o formato de 32 bits utilizado pela matriz de LEDs
   * O formato segue a ordem: G (8 bits) | R (8 bits) | B (8 bits) | 0 (8 bits)
+  * Cada componente passa pela tabela de gama e brilho
   * 
   * @param color Estrutura RGB contendo os componentes da cor
   * @return Valor de 32 bits codificado para a matriz de LEDs
   */
  uint32_t RGBMatrix(RGB color) {
-     // Extrai os componentes de cor
-     unsigned char R = color.red;
-     unsigned char G = color.green;
-     unsigned char B = color.blue;
+     // Extrai os componentes de cor já corrigidos
+     uint32_t R = colorLut[color.red];
+     uint32_t G = colorLut[color.green];
+     uint32_t B = colorLut[color.blue];
      
      // Combina os componentes no formato G|R|B|0
      return (G << 24) | (R << 16) | (B << 8);
  }
  
- /**
-  * Desenha um padrão na matriz de LEDs utilizando as cores especificadas
-  * 
-  * @param drawing Ponteiro para o array que representa o padrão a ser desenhado
-  * @param valorLed Variável para armazenar o valor de cada LED
-  * @param pio Referência ao controlador PIO e máquina de estado
-  * @param color Array de estruturas RGB contendo as cores a serem utilizadas
-  */
- void Draw(double *drawing, uint32_t valorLed, refs pio, RGB *color) {
-     // Estrutura de cor temporária para cada LED
-     RGB finalColor;
+ // Último quadro enviado à matriz, na ordem de envio (evita reenviar quadros iguais)
+ static uint32_t lastFrame[NUM_PIXELS];
+ static bool lastFrameValid = false;
+ 
+ // Quadro recusado pela fila cheia, reenviado por FlushMatrix
+ static uint32_t pendingFrame[NUM_PIXELS];
+ static bool framePending = false;
+ 
+ static bool SendFrame(const uint32_t *frame);
+ 
+ // Monta um quadro percorrendo o padrão de trás para frente (conforme protocolo)
+ static void BuildFrame(Pattern drawing, const uint32_t *palette, uint32_t *frame) {
+     for (int16_t i = (NUM_PIXELS-1), k = 0; i >= 0; i--, k++)
+         frame[k] = palette[(drawing >> (2 * i)) & 0x3];
+ }
+ 
+ // ==================== ANIMAÇÕES ====================
+ 
+ #define FULL_MATRIX PATTERN(PATTERN_ROW(1, 1, 1, 1, 1), PATTERN_ROW(1, 1, 1, 1, 1), \
+                             PATTERN_ROW(1, 1, 1, 1, 1), PATTERN_ROW(1, 1, 1, 1, 1), \
+                             PATTERN_ROW(1, 1, 1, 1, 1))
+ 
+ static const Keyframe alertPulseFrames[] = {
+     { FULL_MATRIX, { {200, 0, 0} }, 400 },
+     { FULL_MATRIX, { {40, 0, 0} }, 400 }
+ };
+ const Animation alertPulse = { alertPulseFrames, 2, true };
+ 
+ static const Keyframe fillBarFrames[] = {
+     { PATTERN(0, 0, 0, 0, PATTERN_ROW(1, 1, 1, 1, 1)), { {0, 40, 90} }, 150 },
+     { PATTERN(0, 0, 0, PATTERN_ROW(1, 1, 1, 1, 1), PATTERN_ROW(1, 1, 1, 1, 1)), { {0, 40, 110} }, 150 },
+     { PATTERN(0, 0, PATTERN_ROW(1, 1, 1, 1, 1), PATTERN_ROW(1, 1, 1, 1, 1), PATTERN_ROW(1, 1, 1, 1, 1)), { {0, 40, 130} }, 150 },
+     { PATTERN(0, PATTERN_ROW(1, 1, 1, 1, 1), PATTERN_ROW(1, 1, 1, 1, 1), PATTERN_ROW(1, 1, 1, 1, 1),
+               PATTERN_ROW(1, 1, 1, 1, 1)), { {0, 40, 150} }, 150 },
+     { FULL_MATRIX, { {0, 40, 170} }, 600 }
+ };
+ const Animation fillBar = { fillBarFrames, 5, true };
+ 
+ // Lida por AnimationTick em contexto de interrupção enquanto o laço a troca
+ static const Animation *volatile animation = NULL;   // Animação em execução (NULL se nenhuma)
+ static uint8_t keyframe;                    // Quadro-chave atual
+ static uint16_t keyframeElapsed;            // Tempo decorrido no quadro-chave atual
+ static int animationTicker = -1;            // Temporizador da animação (HalStartTicker)
+ 
+ // Interpola um componente de cor, com t de 0 a 255
+ static inline uint8_t Lerp(uint8_t from, uint8_t to, uint32_t t) {
+     return from + (((int32_t)to - from) * (int32_t)t >> 8);
+ }
+ 
+ // Avança a animação e envia o quadro correspondente (contexto de interrupção)
+ static void AnimationTick(void) {
+     const Animation *anim = animation;
+     if (!anim)
+         return;
      
-     // Percorre a matriz de LEDs de trás para frente (conforme protocolo)
-     for (int16_t i = (NUM_PIXELS-1); i >= 0; i--)
+     keyframeElapsed += ANIMATION_TICK_MS;
+     while (keyframeElapsed >= anim->frames[keyframe].durationMs)
      {
-         // Define a cor com base no valor no array drawing
-         switch ((int)drawing[i]) {
-             case 1:
-                 finalColor = color[0]; // Primeira cor definida
-                 break;
-             case 2:
-                 finalColor = color[1]; // Segunda cor definida
-                 break;
-             case 3:
-                 finalColor = color[2]; // Terceira cor definida
-                 break;
-             default:
-                 // LED apagado (preto)
-                 finalColor.red = 0;
-                 finalColor.green = 0;
-                 finalColor.blue = 0;
-                 break;
+         keyframeElapsed -= anim->frames[keyframe].durationMs;
+         if (keyframe + 1 < anim->count)
+             keyframe++;
+         else if (anim->loop)
+             keyframe = 0;
+         else
+         {
+             keyframeElapsed = 0;
+             break;
          }
-         
-         // Converte a cor para formato 32 bits e envia ao PIO
-         valorLed = RGBMatrix(finalColor);
-         pio_sm_put_blocking(pio.ref, pio.stateMachine, valorLed);
      }
+     
+     // Paleta em transição para a do quadro-chave seguinte
+     const Keyframe *current = &anim->frames[keyframe];
+     const Keyframe *next = &anim->frames[(keyframe + 1 < anim->count) ? keyframe + 1 : (anim->loop ? 0 : keyframe)];
+     uint32_t t = ((uint32_t)keyframeElapsed << 8) / current->durationMs;
+     
+     uint32_t palette[4] = { 0 };
+     for (int c = 0; c < 3; c++)
+     {
+         RGB blended = {
+             Lerp(current->palette[c].red, next->palette[c].red, t),
+             Lerp(current->palette[c].green, next->palette[c].green, t),
+             Lerp(current->palette[c].blue, next->palette[c].blue, t)
+         };
+         palette[c + 1] = RGBMatrix(blended);
+     }
+     
+     uint32_t frame[NUM_PIXELS];
+     BuildFrame(current->pattern, palette, frame);
+     HalMatrixSubmit(frame);
  }
  
  /**
-  * Retorna um ponteiro para um array que representa um padrão de desenho
-  * Os valores no array determinam qual cor será utilizada:
-  * 0 = desligado, 1-3 = índice da cor no array de cores
+  * Inicia uma animação na matriz. A reprodução acontece no temporizador, sem
+  * custo no laço principal. Enquanto ela estiver ativa, Draw não altera a matriz
   * 
-  * @param pattern Código do padrão desejado
-  * @return Ponteiro para o array do padrão
+  * @param anim Animação a ser reproduzida (sem efeito se já estiver em execução)
   */
- double *Drawing(int pattern) {
-     // Matrizes 5x5 que representam diferentes padrões
+ void PlayAnimation(const Animation *anim) {
+     if (animation == anim)
+         return;
      
-     // Padrão 0 - Matriz vazia (todos LEDs apagados)
-     static double pattern0[] = {
-         0.0, 0.0, 0.0, 0.0, 0.0,
-         0.0, 0.0, 0.0, 0.0, 0.0,
-         0.0, 0.0, 0.0, 0.0, 0.0,
-         0.0, 0.0, 0.0, 0.0, 0.0,
-         0.0, 0.0, 0.0, 0.0, 0.0
-     };
+     StopAnimation();
+     keyframe = 0;
+     keyframeElapsed = 0;
+     framePending = false;
+     animation = anim;
+     animationTicker = HalStartTicker(ANIMATION_TICK_MS * 1000, AnimationTick);
+ }
+ 
+ /**
+  * Interrompe a animação em execução, liberando a matriz para Draw
+  */
+ void StopAnimation(void) {
+     if (!animation)
+         return;
      
-     // Padrão 1 - Linha inferior acesa
-     static double pattern1[] = {
-         0.0, 0.0, 0.0, 0.0, 0.0,
-         0.0, 0.0, 0.0, 0.0, 0.0,
-         0.0, 0.0, 0.0, 0.0, 0.0,
-         1.0, 1.0, 1.0, 1.0, 1.0,
-         1.0, 1.0, 1.0, 1.0, 1.0
-     };
+     HalStopTicker(animationTicker);
+     animationTicker = -1;
+     animation = NULL;
      
-     // Padrão 2 - Matriz cheia (todos LEDs acesos)
-     static double pattern2[] = {
-         0.0, 0.0, 0.0, 0.0, 0.0,
-         1.0, 1.0, 1.0, 1.0, 1.0,
-         1.0, 1.0, 1.0, 1.0, 1.0,
-         1.0, 1.0, 1.0, 1.0, 1.0,
-         1.0, 1.0, 1.0, 1.0, 1.0
+     // O último quadro da animação não corresponde ao cache de Draw
+     lastFrameValid = false;
+ }
+ 
+ /**
+  * Desenha um padrão na matriz de LEDs utilizando as cores especificadas
+  * O quadro só é enviado ao PIO se for diferente do último quadro enviado
+  * 
+  * @param drawing Padrão compactado (2 bits por LED) a ser desenhado
+  * @param color Array de estruturas RGB contendo as cores a serem utilizadas
+  * @return true se o quadro foi enviado, false se era igual ao anterior, a fila
+  *         estava cheia (o quadro fica pendente, ver FlushMatrix) ou uma
+  *         animação está em execução
+  */
+ bool Draw(Pattern drawing, RGB *color) {
+     // A matriz pertence à animação enquanto ela estiver em execução
+     if (animation)
+         return false;
+     
+     // Paleta já no formato da matriz: índice 0 é o LED apagado
+     uint32_t palette[4] = {
+         0,
+         RGBMatrix(color[0]),
+         RGBMatrix(color[1]),
+         RGBMatrix(color[2])
      };
-          
+     
+     uint32_t frame[NUM_PIXELS];
+     BuildFrame(drawing, palette, frame);
+     return SendFrame(frame);
+ }
+ 
+ /**
+  * Desenha um quadro pré-compilado (ver Patterns.h), sem nenhuma conversão
+  * 
+  * @param frame Quadro já na ordem de envio
+  * @return true se o quadro foi enviado, false se era igual ao anterior, a fila
+  *         estava cheia (o quadro fica pendente, ver FlushMatrix) ou uma
+  *         animação está em execução
+  */
+ bool DrawFrame(const MatrixFrame *frame) {
+     if (animation)
+         return false;
+     return SendFrame(frame->words);
+ }
+ 
+ // Envia um quadro se ele for diferente do último e o guarda no cache. Com a
+ // fila cheia ele fica pendente: quem desenha não repete o mesmo quadro, então
+ // descartá-lo deixaria a matriz desatualizada até a próxima mudança
+ static bool SendFrame(const uint32_t *frame) {
+     if (lastFrameValid && memcmp(frame, lastFrame, sizeof(lastFrame)) == 0)
+         return false;
+     
+     memcpy(lastFrame, frame, sizeof(lastFrame));
+     lastFrameValid = true;
+     
+     framePending = !HalMatrixSubmit(frame);
+     if (framePending)
+         memcpy(pendingFrame, frame, sizeof(pendingFrame));
+     return !framePending;
+ }
+ 
+ /**
+  * Reenvia o quadro que a fila cheia recusou. Chamada pelo laço principal, que
+  * repete a chamada enquanto ela retornar false
+  * 
+  * @return true se não resta quadro pendente
+  */
+ bool FlushMatrix(void) {
+     if (framePending)
+         framePending = !HalMatrixSubmit(pendingFrame);
+     return !framePending;
+ }
+ 
+ /**
+  * Retorna o padrão compactado correspondente ao código informado
+  * Cada LED usa 2 bits: 0 = desligado, 1-3 = índice da cor no array de cores
+  * 
+  * @param pattern Código do padrão desejado
+  * @return Padrão compactado (8 bytes, armazenado na flash)
+  */
+ Pattern Drawing(int pattern) {
+     // Padrões 5x5 compilados a partir de arte ASCII (src/Patterns.cpp)
      // Retorna o padrão correspondente ao código solicitado
      switch (pattern) {
          case 1:
-             return pattern1;
+             return basePatterns[1];
          case 2:
-             return pattern2;
+             return basePatterns[2];
          default:
-             return pattern0;
+             return basePatterns[0];
      }
  }
\ No newline at end of file
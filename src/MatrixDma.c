@@ -0,0 +1,105 @@
+#include <MatrixDma.h>
+#include <Leds.h>
+#include <string.h>
+#include "hardware/timer.h"
+ 
+ // Fila de quadros a enviar por DMA. O laço principal insere em queueTail e a
+ // interrupção libera queueHead depois que o quadro termina e o reset passa
+ static uint32_t frameQueue[MATRIX_QUEUE_SIZE][NUM_PIXELS];
+ static volatile uint8_t queueHead = 0;
+ static volatile uint8_t queueTail = 0;
+ static volatile bool matrixBusy = false;
+ static int matrixDma = -1;
+ static int resetAlarm = -1;        // Alarme de hardware exclusivo do fim de quadro
+ static uint32_t frameGapUs;        // Esvaziamento do FIFO e do OSR mais o reset
+ 
+ // Inicia o envio do quadro no início da fila
+ static void StartFrame(void) {
+     dma_channel_transfer_from_buffer_now(matrixDma, frameQueue[queueHead % MATRIX_QUEUE_SIZE], NUM_PIXELS);
+ }
+ 
+ // Chamada após o esvaziamento do FIFO e o tempo de reset: libera o quadro e inicia o próximo
+ static void FrameResetDone(uint alarm) {
+     queueHead++;
+     if (queueHead != queueTail)
+         StartFrame();
+     else
+         matrixBusy = false;
+ }
+ 
+ // Fim da transferência por DMA: o último quadro ainda está saindo do FIFO do PIO
+ static void MatrixDmaHandler(void) {
+     if (!dma_channel_get_irq0_status(matrixDma))
+         return;
+     dma_channel_acknowledge_irq0(matrixDma);
+     
+     // O alarme é só da matriz, então armá-lo não falha por falta de alarme
+     // livre. Prazo já passado (interrupção muito atrasada): o tempo de reset
+     // também já passou e o próximo quadro segue agora
+     if (hardware_alarm_set_target(resetAlarm, make_timeout_time_us(frameGapUs)))
+         FrameResetDone(resetAlarm);
+ }
+ 
+ /**
+  * Configura um canal de DMA para alimentar a máquina de estado da matriz,
+  * com ritmo dado pelo DREQ de transmissão do PIO, e reserva o alarme do fim
+  * de quadro. A máquina de estado já deve estar configurada: a profundidade
+  * do FIFO sai da configuração de junção dela
+  * 
+  * @param pio Referência ao controlador PIO e máquina de estado
+  */
+ void InitMatrixDMA(refs pio) {
+     matrixDma = dma_claim_unused_channel(true);
+     
+     // Ao fim do DMA ainda saem o FIFO inteiro e a palavra no OSR
+     bool joined = pio.ref->sm[pio.stateMachine].shiftctrl & PIO_SM0_SHIFTCTRL_FJOIN_TX_BITS;
+     uint32_t fifoWords = joined ? 2 * MATRIX_FIFO_DEPTH : MATRIX_FIFO_DEPTH;
+     frameGapUs = (fifoWords + 1) * MATRIX_WORD_US + MATRIX_RESET_US;
+     
+     resetAlarm = hardware_alarm_claim_unused(true);
+     hardware_alarm_set_callback(resetAlarm, FrameResetDone);
+     
+     dma_channel_config c = dma_channel_get_default_config(matrixDma);
+     channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+     channel_config_set_read_increment(&c, true);
+     channel_config_set_write_increment(&c, false);
+     channel_config_set_dreq(&c, pio_get_dreq(pio.ref, pio.stateMachine, true));
+     dma_channel_configure(matrixDma, &c, &pio.ref->txf[pio.stateMachine], NULL, NUM_PIXELS, false);
+     
+     dma_channel_set_irq0_enabled(matrixDma, true);
+     irq_add_shared_handler(DMA_IRQ_0, MatrixDmaHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+     irq_set_enabled(DMA_IRQ_0, true);
+ }
+ 
+ /**
+  * Coloca um quadro na fila de envio da matriz. Se nada está sendo enviado,
+  * o envio começa imediatamente; caso contrário o quadro segue assim que o
+  * anterior terminar e o tempo de reset passar
+  * 
+  * A fila tem dois produtores, ambos em Leds.c: o laço principal (Draw e
+  * DrawFrame) e o temporizador das animações (AnimationTick). A inserção não
+  * é atômica entre ler queueTail e publicá-lo, então só é segura porque os
+  * dois nunca produzem ao mesmo tempo: Draw e DrawFrame retornam antes de
+  * chegar aqui enquanto há animação, e o temporizador só existe entre
+  * PlayAnimation e StopAnimation, que o cancela antes de liberar a matriz
+  * 
+  * @param frame Quadro com NUM_PIXELS palavras GRB, na ordem de envio
+  * @return false se a fila está cheia
+  */
+ bool MatrixSubmit(const uint32_t *frame) {
+     uint8_t tail = queueTail;
+     if ((uint8_t)(tail - queueHead) >= MATRIX_QUEUE_SIZE)
+         return false;
+     
+     memcpy(frameQueue[tail % MATRIX_QUEUE_SIZE], frame, sizeof(frameQueue[0]));
+     
+     uint32_t interrupts = save_and_disable_interrupts();
+     queueTail = tail + 1;
+     if (!matrixBusy)
+     {
+         matrixBusy = true;
+         StartFrame();
+     }
+     restore_interrupts(interrupts);
+     return true;
+ }
@@ -0,0 +1,182 @@
+// Desenhos da matriz de LEDs, convertidos em constantes na flash em tempo de compilação.
+// As tabelas são constexpr: um caractere inválido na arte é erro de compilação
+// (e não só de ligação) e os dados vão para .rodata sem inicialização dinâmica.
+
+#include "PatternCompiler.hpp"
+
+using matrix::compile_frame;
+using matrix::compile_pattern;
+using matrix::grb;
+
+// Cores dos símbolos já no nível de saída (sem correção de gama)
+constexpr uint32_t WHITE = grb(4, 4, 4);
+constexpr uint32_t RED = grb(8, 0, 0);
+constexpr uint32_t GREEN = grb(0, 8, 0);
+constexpr uint32_t BLUE = grb(0, 2, 10);
+constexpr uint32_t YELLOW = grb(8, 6, 0);
+
+extern "C" constexpr Pattern basePatterns[3] = {
+    // Padrão 0 - Matriz vazia (todos LEDs apagados)
+    compile_pattern("....."
+                    "....."
+                    "....."
+                    "....."
+                    "....."),
+
+    // Padrão 1 - Linhas inferiores acesas
+    compile_pattern("....."
+                    "....."
+                    "....."
+                    "#####"
+                    "#####"),
+
+    // Padrão 2 - Matriz quase cheia (apenas a linha superior apagada)
+    compile_pattern("....."
+                    "#####"
+                    "#####"
+                    "#####"
+                    "#####"),
+};
+
+// Mesma ordem de enum StatusGlyph
+extern "C" constexpr MatrixFrame statusGlyphs[STATUS_GLYPH_COUNT] = {
+    // GLYPH_DIGIT_0
+    compile_frame(".###."
+                  ".#.#."
+                  ".#.#."
+                  ".#.#."
+                  ".###.", WHITE),
+
+    // GLYPH_DIGIT_1
+    compile_frame("..#.."
+                  ".##.."
+                  "..#.."
+                  "..#.."
+                  ".###.", WHITE),
+
+    // GLYPH_DIGIT_2
+    compile_frame(".###."
+                  "...#."
+                  ".###."
+                  ".#..."
+                  ".###.", WHITE),
+
+    // GLYPH_DIGIT_3
+    compile_frame(".###."
+                  "...#."
+                  "..##."
+                  "...#."
+                  ".###.", WHITE),
+
+    // GLYPH_DIGIT_4
+    compile_frame(".#.#."
+                  ".#.#."
+                  ".###."
+                  "...#."
+                  "...#.", WHITE),
+
+    // GLYPH_DIGIT_5
+    compile_frame(".###."
+                  ".#..."
+                  ".###."
+                  "...#."
+                  ".###.", WHITE),
+
+    // GLYPH_DIGIT_6
+    compile_frame(".###."
+                  ".#..."
+                  ".###."
+                  ".#.#."
+                  ".###.", WHITE),
+
+    // GLYPH_DIGIT_7
+    compile_frame(".###."
+                  "...#."
+                  "..#.."
+                  "..#.."
+                  "..#..", WHITE),
+
+    // GLYPH_DIGIT_8
+    compile_frame(".###."
+                  ".#.#."
+                  ".###."
+                  ".#.#."
+                  ".###.", WHITE),
+
+    // GLYPH_DIGIT_9
+    compile_frame(".###."
+                  ".#.#."
+                  ".###."
+                  "...#."
+                  ".###.", WHITE),
+
+    // GLYPH_CHECK
+    compile_frame("....."
+                  "....#"
+                  "...#."
+                  "#.#.."
+                  ".#...", GREEN),
+
+    // GLYPH_CROSS
+    compile_frame("#...#"
+                  ".#.#."
+                  "..#.."
+                  ".#.#."
+                  "#...#", RED),
+
+    // GLYPH_ARROW_UP
+    compile_frame("..#.."
+                  ".###."
+                  "#.#.#"
+                  "..#.."
+                  "..#..", WHITE),
+
+    // GLYPH_ARROW_DOWN
+    compile_frame("..#.."
+                  "..#.."
+                  "#.#.#"
+                  ".###."
+                  "..#..", WHITE),
+
+    // GLYPH_DROP
+    compile_frame("..#.."
+                  ".###."
+                  "#####"
+                  "#####"
+                  ".###.", BLUE),
+
+    // GLYPH_SUN
+    compile_frame("#.#.#"
+                  ".###."
+                  "#####"
+                  ".###."
+                  "#.#.#", YELLOW),
+
+    // GLYPH_THERMOMETER
+    compile_frame("..#.."
+                  "..#.."
+                  "..#.."
+                  ".+++."
+                  ".+++.", WHITE, RED),
+
+    // GLYPH_EXCLAMATION
+    compile_frame("..#.."
+                  "..#.."
+                  "..#.."
+                  "....."
+                  "..#..", RED),
+
+    // GLYPH_QUESTION
+    compile_frame(".###."
+                  "...#."
+                  "..#.."
+                  "....."
+                  "..#..", YELLOW),
+
+    // GLYPH_HEART
+    compile_frame(".#.#."
+                  "#####"
+                  "#####"
+                  ".###."
+                  "..#..", RED),
+};
@@ -0,0 +1,110 @@
+#include <Profiling.h>
+
+#if PROFILING
+
+#include <string.h>
+
+static const char *const stageNames[PROFILE_STAGE_COUNT] = {
+#define PROFILE_NAME(name, label) label,
+    PROFILE_STAGES(PROFILE_NAME)
+#undef PROFILE_NAME
+};
+
+// Estatísticas de um estágio, escritas só pelo núcleo que o mede
+typedef struct
+{
+    volatile uint32_t sequence;          // Par: estável; ímpar: medida sendo acumulada
+    volatile bool resetRequested;        // Zerar na próxima medida (pedido do console)
+    ProfileStats stats;
+} ProfileSlot;
+
+static ProfileSlot profile[PROFILE_STAGE_COUNT];
+
+/**
+ * Acumula uma medida de um estágio, no núcleo que executa o estágio
+ * @param stage Estágio medido
+ * @param us Duração em µs
+ */
+void ProfileRecord(ProfileStage stage, uint32_t us) {
+    ProfileSlot *slot = &profile[stage];
+    ProfileStats *stats = &slot->stats;
+    uint32_t sequence = slot->sequence;
+    
+    slot->sequence = sequence + 1;
+    __dmb();
+    
+    if (slot->resetRequested) {
+        memset(stats, 0, sizeof(*stats));
+        slot->resetRequested = false;
+    }
+    
+    if (stats->count == 0 || us < stats->min)
+        stats->min = us;
+    if (us > stats->max)
+        stats->max = us;
+    stats->sum += us;
+    stats->count++;
+    
+    // Faixa = quantidade de bits significativos de us
+    uint32_t bucket = us ? 32 - __builtin_clz(us) : 0;
+    if (bucket >= PROFILE_BUCKETS)
+        bucket = PROFILE_BUCKETS - 1;
+    stats->histogram[bucket]++;
+    
+    __dmb();
+    slot->sequence = sequence + 2;
+}
+
+// Copia as estatísticas de um estágio sem travar o núcleo que o mede
+static void CopyStats(const ProfileSlot *slot, ProfileStats *stats) {
+    uint32_t begin;
+    
+    do {
+        begin = slot->sequence;
+        __dmb();
+        *stats = slot->stats;
+        __dmb();
+    } while ((begin & 1) || slot->sequence != begin);
+    
+    if (slot->resetRequested)
+        stats->count = 0;
+}
+
+/**
+ * Imprime as estatísticas e os histogramas de todos os estágios medidos
+ */
+void PrintProfile(void) {
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        ProfileStats stats;
+        CopyStats(&profile[i], &stats);
+        if (stats.count == 0)
+            continue;
+        
+        printf("%s: %lu medidas, min %lu us, media %lu us, max %lu us\n", stageNames[i],
+               (unsigned long)stats.count, (unsigned long)stats.min,
+               (unsigned long)(stats.sum / stats.count), (unsigned long)stats.max);
+        
+        for (int bucket = 0; bucket < PROFILE_BUCKETS; bucket++) {
+            if (!stats.histogram[bucket])
+                continue;
+            
+            uint32_t low = bucket ? 1u << (bucket - 1) : 0;
+            if (bucket == PROFILE_BUCKETS - 1)
+                printf("  >= %lu us: %lu\n", (unsigned long)low, (unsigned long)stats.histogram[bucket]);
+            else
+                printf("  %lu-%lu us: %lu\n", (unsigned long)low, (unsigned long)(bucket ? (1u << bucket) - 1 : 0),
+                       (unsigned long)stats.histogram[bucket]);
+        }
+    }
+}
+
+/**
+ * Zera as estatísticas de todos os estágios; cada uma é zerada de fato pelo
+ * núcleo que a mede, na próxima medida, e até lá aparece vazia
+ */
+void ResetProfile(void) {
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++)
+        profile[i].resetRequested = true;
+}
+
+#endif
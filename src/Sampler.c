@@ -0,0 +1,105 @@
+#include <Sampler.h>
+
+// O round-robin percorre as entradas sempre na mesma ordem, então a posição
+// de uma amostra no anel identifica a entrada de origem
+_Static_assert(SAMPLER_RING_SIZE % SAMPLER_CHANNELS == 0, "o anel deve conter voltas completas do round-robin");
+
+// Anel de amostras escrito pelo DMA; o alinhamento permite o modo de anel do canal
+static uint16_t ring[SAMPLER_RING_SIZE] __attribute__((aligned(SAMPLER_RING_SIZE * sizeof(uint16_t))));
+
+// Quantidade de transferências por volta, relida pelo canal de controle
+static const uint32_t ringTransfers = SAMPLER_RING_SIZE;
+
+static int dataChannel;
+static int controlChannel;
+
+// Posição no anel da próxima amostra a ser escrita pelo DMA
+static inline uint16_t WritePosition(void) {
+    uintptr_t address = dma_hw->ch[dataChannel].write_addr;
+    return ((address - (uintptr_t)ring) / sizeof(uint16_t)) & (SAMPLER_RING_SIZE - 1);
+}
+
+// Entrada do ADC que produziu a amostra na posição indicada
+static inline uint8_t InputAt(uint16_t position) {
+    return SAMPLER_FIRST_INPUT + position % SAMPLER_CHANNELS;
+}
+
+/**
+ * Inicia a amostragem contínua: o ADC converte as entradas em round-robin a
+ * uma taxa fixa e o DMA esvazia o FIFO em um anel, sem intervenção da CPU.
+ * Um segundo canal de DMA rearma o primeiro a cada volta do anel
+ */
+void InitSampler(void) {
+    adc_init();
+    adc_gpio_init(VRX_PIN);
+    adc_gpio_init(VRY_PIN);
+    
+    adc_select_input(SAMPLER_FIRST_INPUT);
+    adc_set_round_robin(SAMPLER_INPUT_MASK);
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv((float)ADC_CLOCK_HZ / (SAMPLER_RATE_HZ * SAMPLER_CHANNELS) - 1);
+    
+    dataChannel = dma_claim_unused_channel(true);
+    controlChannel = dma_claim_unused_channel(true);
+    
+    // Canal de dados: FIFO do ADC -> anel, no ritmo do DREQ do ADC
+    dma_channel_config data = dma_channel_get_default_config(dataChannel);
+    channel_config_set_transfer_data_size(&data, DMA_SIZE_16);
+    channel_config_set_read_increment(&data, false);
+    channel_config_set_write_increment(&data, true);
+    channel_config_set_ring(&data, true, SAMPLER_RING_BITS + 1);
+    channel_config_set_dreq(&data, DREQ_ADC);
+    channel_config_set_chain_to(&data, controlChannel);
+    dma_channel_configure(dataChannel, &data, ring, &adc_hw->fifo, SAMPLER_RING_SIZE, false);
+    
+    // Canal de controle: recarrega a contagem do canal de dados e o dispara
+    dma_channel_config control = dma_channel_get_default_config(controlChannel);
+    channel_config_set_transfer_data_size(&control, DMA_SIZE_32);
+    channel_config_set_read_increment(&control, false);
+    channel_config_set_write_increment(&control, false);
+    dma_channel_configure(controlChannel, &control, &dma_hw->ch[dataChannel].al1_transfer_count_trig,
+                          &ringTransfers, 1, false);
+    
+    adc_fifo_drain();
+    dma_channel_start(dataChannel);
+    adc_run(true);
+}
+
+/**
+ * Retorna a amostra mais recente de uma entrada, sem bloquear
+ *
+ * @param input Número da entrada do ADC
+ * @return Última amostra de 12 bits convertida nessa entrada
+ */
+uint16_t SamplerLatest(uint8_t input) {
+    uint16_t position = (WritePosition() - 1) & (SAMPLER_RING_SIZE - 1);
+    uint16_t back = (position % SAMPLER_CHANNELS + SAMPLER_CHANNELS - (input - SAMPLER_FIRST_INPUT)) % SAMPLER_CHANNELS;
+    return ring[(position - back) & (SAMPLER_RING_SIZE - 1)];
+}
+
+/**
+ * Copia as amostras de uma entrada produzidas desde a última leitura, sem bloquear
+ * O anel guarda SAMPLER_RING_SIZE / SAMPLER_CHANNELS amostras por entrada; leituras
+ * mais espaçadas que isso perdem as amostras mais antigas
+ *
+ * @param input Número da entrada do ADC
+ * @param out Destino das amostras, da mais antiga para a mais recente
+ * @param max Capacidade de out
+ * @param cursor Posição da última leitura no anel (mantida pelo chamador, começa em 0)
+ * @return Quantidade de amostras copiadas
+ */
+uint16_t SamplerRead(uint8_t input, uint16_t *out, uint16_t max, uint16_t *cursor) {
+    uint16_t end = WritePosition();
+    uint16_t count = 0;
+    uint16_t position = *cursor;
+    
+    while (position != end && count < max)
+    {
+        if (InputAt(position) == input)
+            out[count++] = ring[position];
+        position = (position + 1) & (SAMPLER_RING_SIZE - 1);
+    }
+    
+    *cursor = position;
+    return count;
+}
@@ -0,0 +1,134 @@
+#include <Scheduler.h>
+#include <Hal.h>
+
+// Prazo de uma tarefa por evento ainda não vista pelo escalonador desde a sinalização
+#define UNSTAMPED UINT64_MAX
+
+// Tarefas registradas, percorridas em ordem de registro
+static Task tasks[SCHEDULER_MAX_TASKS];
+static uint8_t taskCount = 0;
+
+// Tempo total dormindo e tempo total desde o último relatório
+static uint64_t idleUs = 0;
+static uint64_t reportStart = 0;
+
+/**
+ * Registra uma tarefa, com a primeira ativação imediata (tarefas periódicas)
+ * @param name Nome usado no relatório
+ * @param run Função executada a cada ativação
+ * @param periodUs Período em µs, ou TASK_ON_EVENT para rodar só quando sinalizada
+ * @param priority Desempate entre tarefas com o mesmo prazo (0 = mais prioritária)
+ * @return Identificador da tarefa, ou -1 se não houver espaço
+ */
+int AddTask(const char *name, TaskFunction run, uint32_t periodUs, uint8_t priority) {
+    if (taskCount == SCHEDULER_MAX_TASKS)
+        return -1;
+    
+    Task *task = &tasks[taskCount];
+    task->name = name;
+    task->run = run;
+    task->periodUs = periodUs;
+    task->priority = priority;
+    task->pending = false;
+    task->deadline = periodUs == TASK_ON_EVENT ? UNSTAMPED : HalTimeUs();
+    task->runs = 0;
+    task->overruns = 0;
+    task->maxRunUs = 0;
+    
+    return taskCount++;
+}
+
+/**
+ * Marca uma tarefa por evento para execução. Pode ser chamada de interrupções:
+ * só escreve pending, e o prazo de 64 bits, que não é gravado de forma
+ * atômica, é atribuído pelo escalonador quando ele vê a marca
+ * @param task Identificador retornado por AddTask
+ */
+void SignalTask(int task) {
+    tasks[task].pending = true;
+    
+    // Acorda o laço do escalonador se ele estiver dormindo
+    HalWake();
+}
+
+/**
+ * Executa as tarefas indefinidamente, sempre a pronta de prazo mais cedo
+ * Sem tarefa pronta, o núcleo dorme até o próximo prazo ou uma interrupção
+ */
+_Noreturn void RunScheduler(void) {
+    reportStart = HalTimeUs();
+    
+    while (true) {
+        uint64_t now = HalTimeUs();
+        uint64_t wake = UINT64_MAX;
+        Task *next = NULL;
+        
+        for (int i = 0; i < taskCount; i++) {
+            Task *task = &tasks[i];
+            
+            if (task->periodUs == TASK_ON_EVENT) {
+                if (!task->pending)
+                    continue;
+                // Sinalizada desde a última passada: pronta a partir de agora
+                if (task->deadline == UNSTAMPED)
+                    task->deadline = now;
+            }
+            
+            if (task->deadline > now) {
+                if (task->deadline < wake)
+                    wake = task->deadline;
+                continue;
+            }
+            
+            if (!next || task->deadline < next->deadline ||
+                (task->deadline == next->deadline && task->priority < next->priority))
+                next = task;
+        }
+        
+        if (!next) {
+            HalSleepUntil(wake);
+            idleUs += HalTimeUs() - now;
+            continue;
+        }
+        
+        next->pending = false;
+        next->run();
+        
+        uint64_t end = HalTimeUs();
+        uint32_t duration = end - now;
+        next->runs++;
+        if (duration > next->maxRunUs)
+            next->maxRunUs = duration;
+        
+        // Próxima ativação no ritmo do período; se ela também já passou, a
+        // ativação foi perdida e a tarefa é realinhada a partir de agora
+        if (next->periodUs == TASK_ON_EVENT) {
+            next->deadline = UNSTAMPED;
+        } else {
+            next->deadline += next->periodUs;
+            if (next->deadline < end) {
+                next->overruns++;
+                next->deadline = end + next->periodUs;
+            }
+        }
+    }
+}
+
+/**
+ * Imprime as estatísticas de cada tarefa e a fração de tempo ociosa desde o
+ * relatório anterior (comando stats do console)
+ */
+void PrintSchedulerStats(void) {
+    uint64_t now = HalTimeUs();
+    uint64_t elapsed = now - reportStart;
+    
+    for (int i = 0; i < taskCount; i++)
+        printf("%s: %lu execucoes, %lu atrasos, %lu us max\n", tasks[i].name,
+               (unsigned long)tasks[i].runs, (unsigned long)tasks[i].overruns, (unsigned long)tasks[i].maxRunUs);
+    
+    if (elapsed)
+        printf("Ocioso: %lu%%\n", (unsigned long)(idleUs * 100 / elapsed));
+    
+    idleUs = 0;
+    reportStart = now;
+}
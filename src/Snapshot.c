@@ -0,0 +1,46 @@
+#include <Snapshot.h>
+#include <Hal.h>
+
+/**
+ * Publica um novo instantâneo e acorda o consumidor se ele estiver em HalSleepUntil
+ * Somente um núcleo pode publicar em cada canal
+ * @param channel Canal de destino
+ * @param snapshot Estado a publicar
+ */
+void PublishSnapshot(SnapshotChannel *channel, const DisplaySnapshot *snapshot) {
+    uint32_t sequence = channel->sequence;
+    
+    channel->sequence = sequence + 1;
+    __dmb();
+    channel->data = *snapshot;
+    __dmb();
+    channel->sequence = sequence + 2;
+    
+    HalWake();
+}
+
+/**
+ * Copia o instantâneo mais recente, se houver um ainda não lido
+ * @param channel Canal de origem
+ * @param snapshot Destino da cópia
+ * @param lastSequence Sequência da última leitura do consumidor (começa em 0)
+ * @return false se nada foi publicado desde a última leitura
+ */
+bool ReadSnapshot(SnapshotChannel *channel, DisplaySnapshot *snapshot, uint32_t *lastSequence) {
+    uint32_t begin;
+    
+    do {
+        begin = channel->sequence;
+        if (begin == *lastSequence)
+            return false;
+        if (begin & 1)
+            continue;
+        
+        __dmb();
+        *snapshot = channel->data;
+        __dmb();
+    } while ((begin & 1) || channel->sequence != begin);
+    
+    *lastSequence = begin;
+    return true;
+}
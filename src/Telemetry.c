@@ -0,0 +1,102 @@
+#include <Telemetry.h>
+#include <Hal.h>
+#include <Checksum.h>
+#include <string.h>
+
+// Anel sem trava: o controle produz, a tarefa de telemetria consome. Cada lado
+// escreve somente o próprio índice; cheio, o registro novo é descartado, então
+// o controle nunca espera pela porta serial
+static TelemetryRecord ring[TELEMETRY_RING_SIZE];
+static volatile uint32_t head = 0;
+static volatile uint32_t tail = 0;
+static volatile uint32_t dropped = 0;
+static bool pendingDrop = false;   // Houve descarte desde o último registro aceito
+static volatile bool enabled = false;   // Desligada: a serial fica só com o texto do console
+
+/**
+ * Copia um registro para o anel. Tempo constante, sem acesso à porta serial
+ * @param record Registro a enviar; recebe TELEMETRY_FLAG_DROPPED se houve perda antes dele
+ * @return false se o anel estava cheio e o registro foi descartado
+ */
+bool PushTelemetry(TelemetryRecord *record) {
+    uint32_t position = head;
+    
+    // Desligada não é perda: nada é contado como descarte
+    if (!enabled)
+        return false;
+    
+    if (position - tail == TELEMETRY_RING_SIZE) {
+        dropped++;
+        pendingDrop = true;
+        return false;
+    }
+    
+    if (pendingDrop) {
+        record->flags |= TELEMETRY_FLAG_DROPPED;
+        pendingDrop = false;
+    }
+    
+    ring[position & (TELEMETRY_RING_SIZE - 1)] = *record;
+    __dmb();
+    head = position + 1;
+    return true;
+}
+
+/**
+ * Envia até TELEMETRY_FRAMES_PER_DRAIN registros como pacotes com checksum
+ * Feita para rodar como tarefa de baixa prioridade
+ */
+void DrainTelemetry(void) {
+    uint8_t frame[3 + sizeof(TelemetryRecord) + 2];
+    
+    if (!enabled)
+        return;
+    
+    for (int i = 0; i < TELEMETRY_FRAMES_PER_DRAIN; i++) {
+        uint32_t position = tail;
+        if (position == head)
+            return;
+        
+        __dmb();
+        frame[0] = TELEMETRY_SYNC0;
+        frame[1] = TELEMETRY_SYNC1;
+        frame[2] = sizeof(TelemetryRecord);
+        memcpy(&frame[3], &ring[position & (TELEMETRY_RING_SIZE - 1)], sizeof(TelemetryRecord));
+        __dmb();
+        tail = position + 1;
+        
+        uint16_t checksum = Fletcher16(&frame[2], 1 + sizeof(TelemetryRecord));
+        frame[sizeof(frame) - 2] = checksum & 0xFF;
+        frame[sizeof(frame) - 1] = checksum >> 8;
+        
+        // Sem tradução de fim de linha: o pacote é binário
+        HalSerialWrite(frame, sizeof(frame));
+    }
+}
+
+/**
+ * Liga ou desliga o envio dos pacotes. Os pacotes binários dividem a serial
+ * com o console, então a telemetria começa desligada e só é ligada a pedido
+ * Deve ser chamada no mesmo núcleo que PushTelemetry e DrainTelemetry
+ * @param enable true para enviar os pacotes
+ */
+void EnableTelemetry(bool enable) {
+    // Registros que ficaram no anel antes de desligar já estão velhos
+    if (enable && !enabled)
+        tail = head;
+    enabled = enable;
+}
+
+/**
+ * @return true se os pacotes estão sendo enviados
+ */
+bool TelemetryEnabled(void) {
+    return enabled;
+}
+
+/**
+ * @return Quantidade de registros descartados com o anel cheio desde o boot
+ */
+uint32_t DroppedTelemetry(void) {
+    return dropped;
+}
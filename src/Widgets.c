@@ -0,0 +1,80 @@
+#include <Widgets.h>
+
+#define CELL_SIZE 8   // Largura e altura de um caractere da fonte
+#define MARKER_SIZE 4 // Lado do quadrado que indica o controle ativo
+
+/**
+ * Desenha um rótulo estático. Deve ser chamada apenas na montagem da tela,
+ * já que os rótulos não são redesenhados a cada atualização
+ *
+ * @param ssd Estrutura de controle do display
+ * @param text Texto do rótulo
+ * @param x Coluna inicial
+ * @param y Linha inicial
+ */
+void DrawLabel(ssd1306_t *ssd, const char *text, uint8_t x, uint8_t y) {
+    ssd1306_draw_string(ssd, text, x, y);
+}
+
+/**
+ * Inicializa um campo numérico, marcando-o para ser desenhado na primeira atualização
+ *
+ * @param field Campo a ser inicializado
+ * @param x Coluna inicial dos dígitos
+ * @param y Linha inicial dos dígitos
+ * @param digits Quantidade de dígitos reservados
+ * @param markerX Coluna do marcador de controle ativo
+ */
+void InitNumericField(NumericField *field, uint8_t x, uint8_t y, uint8_t digits, uint8_t markerX) {
+    field->x = x;
+    field->y = y;
+    field->digits = digits;
+    field->markerX = markerX;
+    field->lastValue = -1;
+    field->lastMarker = -1;
+}
+
+/**
+ * Atualiza um campo numérico. Os dígitos só são redesenhados se o valor mudou
+ * e o marcador só se o seu estado mudou, de modo que apenas as páginas
+ * afetadas ficam marcadas para envio ao display
+ *
+ * @param ssd Estrutura de controle do display
+ * @param field Campo a ser atualizado
+ * @param value Valor atual
+ * @param marker Indica se o marcador de controle ativo deve aparecer
+ * @return true se algo foi redesenhado
+ */
+bool UpdateNumericField(ssd1306_t *ssd, NumericField *field, uint8_t value, bool marker) {
+    bool changed = false;
+
+    if (field->lastValue != value) {
+        // Converte o valor em dígitos da direita para a esquerda, sem sprintf
+        uint8_t x = field->x + (field->digits - 1) * CELL_SIZE;
+        uint8_t remaining = value;
+        uint8_t cell = 0;
+
+        do {
+            ssd1306_draw_char(ssd, '0' + remaining % 10, x, field->y);
+            remaining /= 10;
+            x -= CELL_SIZE;
+            cell++;
+        } while (remaining && cell < field->digits);
+
+        // Limpa as posições à esquerda que ficaram sem dígito
+        if (cell < field->digits)
+            ssd1306_rect(ssd, field->y, field->x, (field->digits - cell) * CELL_SIZE, CELL_SIZE, false, true);
+
+        field->lastValue = value;
+        changed = true;
+    }
+
+    if (field->lastMarker != marker) {
+        uint8_t offset = (CELL_SIZE - MARKER_SIZE) / 2;
+        ssd1306_rect(ssd, field->y + offset, field->markerX + offset, MARKER_SIZE, MARKER_SIZE, marker, true);
+        field->lastMarker = marker;
+        changed = true;
+    }
+
+    return changed;
+}
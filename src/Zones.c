@@ -0,0 +1,51 @@
+#include <string.h>
+#include "Zones.h"
+
+/**
+ * Inicia todas as zonas com os mesmos valores e severidade normal
+ * @param zones Estado das zonas
+ * @param defaults Valor inicial de cada grandeza, na ordem de Quantity
+ */
+void InitZones(ZoneState *zones, const uint8_t defaults[QUANTITY_COUNT]) {
+    for (int q = 0; q < QUANTITY_COUNT; q++)
+        memset(zones->values[q], defaults[q], ZONE_COUNT);
+
+    memset(zones->severity, SEVERITY_NORMAL, sizeof(zones->severity));
+    memset(zones->warningFlags, 0, sizeof(zones->warningFlags));
+    memset(zones->criticalFlags, 0, sizeof(zones->criticalFlags));
+}
+
+/**
+ * Classifica todas as zonas em uma passada por grandeza e atualiza os mapas de bits
+ * @param zones Estado das zonas
+ * @return Maior severidade entre todas as zonas
+ */
+Severity EvaluateZones(ZoneState *zones) {
+    uint8_t combined[ZONE_COUNT];
+    memset(combined, SEVERITY_NORMAL, sizeof(combined));
+
+    for (int q = 0; q < QUANTITY_COUNT; q++)
+        ClassifyBatch((Quantity)q, zones->values[q], zones->severity[q], combined, ZONE_COUNT);
+
+    // Compacta a severidade combinada em um bit por zona, 32 zonas por palavra
+    uint32_t anyWarning = 0, anyCritical = 0;
+
+    for (int w = 0; w < ZONE_WORDS; w++) {
+        uint32_t warning = 0, critical = 0;
+        int first = w * 32;
+        int last = first + 32 < ZONE_COUNT ? first + 32 : ZONE_COUNT;
+
+        for (int zone = first; zone < last; zone++) {
+            uint32_t bit = 1u << (zone - first);
+            warning |= combined[zone] >= SEVERITY_WARNING ? bit : 0;
+            critical |= combined[zone] == SEVERITY_CRITICAL ? bit : 0;
+        }
+
+        zones->warningFlags[w] = warning;
+        zones->criticalFlags[w] = critical;
+        anyWarning |= warning;
+        anyCritical |= critical;
+    }
+
+    return anyCritical ? SEVERITY_CRITICAL : anyWarning ? SEVERITY_WARNING : SEVERITY_NORMAL;
+}
@@ -1,5 +1,49 @@
+#include <string.h>
 #include "ssd1306.h"
-#include "font.h"
+#include "Font.h"
+
+// Custo aproximado, em bytes no barramento, de reposicionar a janela de escrita
+// (endereço, byte de controle e 6 bytes de comando em uma única transação)
+#define SSD1306_WINDOW_OVERHEAD 8
+
+// Atlas da fonte na flash: um glifo de FONT_WIDTH colunas por caractere imprimível
+#define FONT_ATLAS_ENTRY(c, b0, b1, b2, b3, b4, b5, b6, b7) { b0, b1, b2, b3, b4, b5, b6, b7 },
+static const uint8_t font_atlas[FONT_GLYPH_COUNT][FONT_WIDTH] = {
+  FONT_GLYPHS(FONT_ATLAS_ENTRY)
+};
+
+// Variante proporcional: primeira coluna desenhada e largura útil de cada glifo
+#define FONT_LEFT_ENTRY(c, b0, b1, b2, b3, b4, b5, b6, b7) FONT_LEFT(b0, b1, b2, b3, b4, b5, b6, b7),
+static const uint8_t font_left[FONT_GLYPH_COUNT] = {
+  FONT_GLYPHS(FONT_LEFT_ENTRY)
+};
+
+#define FONT_INK_ENTRY(c, b0, b1, b2, b3, b4, b5, b6, b7) \
+  FONT_RIGHT(b0, b1, b2, b3, b4, b5, b6, b7) - FONT_LEFT(b0, b1, b2, b3, b4, b5, b6, b7),
+static const uint8_t font_ink[FONT_GLYPH_COUNT] = {
+  FONT_GLYPHS(FONT_INK_ENTRY)
+};
+
+// Sequência de inicialização, enviada em uma única transação a partir da flash
+static const uint8_t ssd1306_init_sequence[] = {
+  SSD1306_CONTROL_CMD_STREAM,
+  SET_DISP | 0x00,
+  SET_MEM_ADDR, 0x01,
+  SET_DISP_START_LINE | 0x00,
+  SET_SEG_REMAP | 0x01,
+  SET_MUX_RATIO, HEIGHT - 1,
+  SET_COM_OUT_DIR | 0x08,
+  SET_DISP_OFFSET, 0x00,
+  SET_COM_PIN_CFG, 0x12,
+  SET_DISP_CLK_DIV, 0x80,
+  SET_PRECHARGE, 0xF1,
+  SET_VCOM_DESEL, 0x30,
+  SET_CONTRAST, 0xFF,
+  SET_ENTIRE_ON,
+  SET_NORM_INV,
+  SET_CHARGE_PUMP, 0x14,
+  SET_DISP | 0x01
+};
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
   ssd->width = width;
@@ -11,37 +55,50 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
   ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
   ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+  ssd->gddram = calloc(ssd->bufsize - 1, sizeof(uint8_t));
+  ssd->synced = false;
+  ssd->dirty_pages = 0;
+  ssd->dma_channel = -1;
+  ssd->front_buffer = NULL;
+  ssd->front_len = 0;
+}
+
+// Marca as colunas [x0, x1] das páginas [page0, page1] como alteradas
+static inline void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1) {
+  for (uint8_t page = page0; page <= page1; ++page) {
+    uint8_t bit = 1u << page;
+    if (!(ssd->dirty_pages & bit)) {
+      ssd->dirty_pages |= bit;
+      ssd->dirty_x0[page] = x0;
+      ssd->dirty_x1[page] = x1;
+    } else {
+      if (x0 < ssd->dirty_x0[page])
+        ssd->dirty_x0[page] = x0;
+      if (x1 > ssd->dirty_x1[page])
+        ssd->dirty_x1[page] = x1;
+    }
+  }
+}
+
+// Define a janela de escrita da GDDRAM (colunas e páginas inclusivas)
+static void ssd1306_set_window(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1) {
+  const uint8_t list[] = {
+    SSD1306_CONTROL_CMD_STREAM,
+    SET_COL_ADDR, x0, x1,
+    SET_PAGE_ADDR, page0, page1
+  };
+  ssd1306_command_list(ssd, list, sizeof(list));
 }
 
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  ssd1306_command_list(ssd, ssd1306_init_sequence, sizeof(ssd1306_init_sequence));
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  // Um envio por DMA em andamento não pode ser interrompido
+  while (ssd1306_busy(ssd))
+    tight_loop_contents();
+
   ssd->port_buffer[1] = command;
   i2c_write_blocking(
     ssd->i2c_port,
@@ -52,13 +109,21 @@ void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   );
 }
 
+/**
+ * Envia uma lista de comandos em uma única transação I2C.
+ * @param list Sequência iniciada por SSD1306_CONTROL_CMD_STREAM, seguida dos
+ *             comandos e seus argumentos (pode residir na flash)
+ * @param len Tamanho da sequência em bytes, incluindo o byte de controle
+ */
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *list, size_t len) {
+  while (ssd1306_busy(ssd))
+    tight_loop_contents();
+
+  i2c_write_blocking(ssd->i2c_port, ssd->address, list, len, false);
+}
+
 void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
+  ssd1306_set_window(ssd, 0, ssd->width - 1, 0, ssd->pages - 1);
   i2c_write_blocking(
     ssd->i2c_port,
     ssd->address,
@@ -66,52 +131,241 @@ void ssd1306_send_data(ssd1306_t *ssd) {
     ssd->bufsize,
     false
   );
+  memcpy(ssd->gddram, ssd->ram_buffer + 1, ssd->bufsize - 1);
+  ssd->synced = true;
+  ssd->dirty_pages = 0;
+}
+
+/**
+ * Recorta as faixas sujas de cada página, descartando as colunas das bordas
+ * que já coincidem com o conteúdo do display.
+ * @return Custo estimado, em bytes, de enviar cada página suja separadamente
+ */
+static size_t ssd1306_trim_dirty(ssd1306_t *ssd) {
+  size_t cost = 0;
+  for (uint8_t page = 0; page < ssd->pages; ++page) {
+    if (!(ssd->dirty_pages & (1u << page)))
+      continue;
+
+    uint8_t x0 = ssd->dirty_x0[page];
+    uint8_t x1 = ssd->dirty_x1[page];
+    while (x0 <= x1 && ssd->ram_buffer[1 + x0 * ssd->pages + page] == ssd->gddram[x0 * ssd->pages + page])
+      ++x0;
+    while (x1 > x0 && ssd->ram_buffer[1 + x1 * ssd->pages + page] == ssd->gddram[x1 * ssd->pages + page])
+      --x1;
+
+    if (x0 > x1) {
+      ssd->dirty_pages &= ~(1u << page);
+      continue;
+    }
+    ssd->dirty_x0[page] = x0;
+    ssd->dirty_x1[page] = x1;
+    cost += (x1 - x0 + 2) + SSD1306_WINDOW_OVERHEAD;
+  }
+  return cost;
+}
+
+/**
+ * Envia ao display apenas as colunas alteradas de cada página suja.
+ * As faixas marcadas pelas funções de desenho são recortadas contra a cópia
+ * do que já está no display, de modo que redesenhar o mesmo conteúdo não gera
+ * tráfego. Se a soma das janelas parciais custar mais que um quadro inteiro,
+ * o quadro completo é enviado.
+ * @return Quantidade de bytes de dados enviados (0 se nada mudou)
+ */
+size_t ssd1306_flush(ssd1306_t *ssd) {
+  if (!ssd->synced) {
+    ssd1306_send_data(ssd);
+    return ssd->bufsize;
+  }
+
+  size_t cost = ssd1306_trim_dirty(ssd);
+  if (!ssd->dirty_pages)
+    return 0;
+
+  if (cost >= ssd->bufsize + SSD1306_WINDOW_OVERHEAD) {
+    ssd1306_send_data(ssd);
+    return ssd->bufsize;
+  }
+
+  // No modo de endereçamento vertical os bytes de uma página não são
+  // contíguos no buffer, então cada janela é montada em um buffer auxiliar
+  uint8_t window[WIDTH + 1];
+  window[0] = 0x40;
+  size_t sent = 0;
+
+  for (uint8_t page = 0; page < ssd->pages; ++page) {
+    if (!(ssd->dirty_pages & (1u << page)))
+      continue;
+
+    uint8_t x0 = ssd->dirty_x0[page];
+    uint8_t x1 = ssd->dirty_x1[page];
+    size_t len = 1;
+    for (uint8_t x = x0; x <= x1; ++x) {
+      uint16_t index = x * ssd->pages + page;
+      window[len++] = ssd->ram_buffer[index + 1];
+      ssd->gddram[index] = ssd->ram_buffer[index + 1];
+    }
+
+    ssd1306_set_window(ssd, x0, x1, page, page);
+    i2c_write_blocking(ssd->i2c_port, ssd->address, window, len, false);
+    sent += len;
+  }
+
+  ssd->dirty_pages = 0;
+  return sent;
+}
+
+/**
+ * Prepara o envio assíncrono: reserva um canal de DMA ligado ao DREQ de
+ * transmissão do I2C e aloca o buffer frontal. Depois disso o ram_buffer passa
+ * a ser o buffer traseiro, onde a aplicação desenha enquanto o frontal é enviado.
+ */
+void ssd1306_init_dma(ssd1306_t *ssd) {
+  ssd->front_buffer = calloc(ssd->bufsize, sizeof(uint16_t));
+  ssd->dma_channel = dma_claim_unused_channel(true);
+
+  dma_channel_config c = dma_channel_get_default_config(ssd->dma_channel);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, i2c_get_dreq(ssd->i2c_port, true));
+  dma_channel_configure(
+    ssd->dma_channel,
+    &c,
+    &i2c_get_hw(ssd->i2c_port)->data_cmd,
+    ssd->front_buffer,
+    0,
+    false
+  );
+}
+
+/**
+ * Indica se ainda há um quadro sendo enviado por DMA. O envio só termina
+ * quando o DMA acabou e o FIFO do I2C esvaziou com o barramento livre.
+ */
+bool ssd1306_busy(ssd1306_t *ssd) {
+  if (ssd->dma_channel < 0)
+    return false;
+  if (dma_channel_is_busy(ssd->dma_channel))
+    return true;
+
+  uint32_t status = i2c_get_hw(ssd->i2c_port)->status;
+  return !(status & I2C_IC_STATUS_TFE_BITS) || (status & I2C_IC_STATUS_MST_ACTIVITY_BITS);
+}
+
+/**
+ * Troca os buffers: copia a região alterada do buffer traseiro para o frontal,
+ * já codificada para o registrador de dados do I2C (STOP na última palavra).
+ * A aplicação pode continuar desenhando no ram_buffer logo em seguida.
+ * @return false se o quadro anterior ainda está em envio ou se nada mudou
+ */
+bool ssd1306_swap_buffers(ssd1306_t *ssd) {
+  if (ssd1306_busy(ssd))
+    return false;
+
+  if (!ssd->synced)
+    ssd1306_mark_dirty(ssd, 0, ssd->width - 1, 0, ssd->pages - 1);
+  else
+    ssd1306_trim_dirty(ssd);
+
+  if (!ssd->dirty_pages)
+    return false;
+
+  // Janela única que cobre todas as páginas sujas
+  uint8_t page0 = ssd->pages, page1 = 0;
+  uint8_t x0 = ssd->width - 1, x1 = 0;
+  for (uint8_t page = 0; page < ssd->pages; ++page) {
+    if (!(ssd->dirty_pages & (1u << page)))
+      continue;
+    if (page < page0)
+      page0 = page;
+    page1 = page;
+    if (ssd->dirty_x0[page] < x0)
+      x0 = ssd->dirty_x0[page];
+    if (ssd->dirty_x1[page] > x1)
+      x1 = ssd->dirty_x1[page];
+  }
+
+  // Modo de endereçamento vertical: a janela é percorrida coluna a coluna
+  size_t len = 0;
+  ssd->front_buffer[len++] = 0x40;
+  for (uint8_t x = x0; x <= x1; ++x) {
+    for (uint8_t page = page0; page <= page1; ++page) {
+      uint16_t index = x * ssd->pages + page;
+      ssd->front_buffer[len++] = ssd->ram_buffer[index + 1];
+      ssd->gddram[index] = ssd->ram_buffer[index + 1];
+    }
+  }
+  ssd->front_buffer[len - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+  ssd->front_len = len;
+  ssd->front_x0 = x0;
+  ssd->front_x1 = x1;
+  ssd->front_page0 = page0;
+  ssd->front_page1 = page1;
+  ssd->synced = true;
+  ssd->dirty_pages = 0;
+  return true;
+}
+
+/**
+ * Posiciona a janela de escrita e dispara o envio do buffer frontal por DMA.
+ * Retorna imediatamente; use ssd1306_busy() para saber quando terminou.
+ */
+void ssd1306_send_data_async(ssd1306_t *ssd) {
+  ssd1306_set_window(ssd, ssd->front_x0, ssd->front_x1, ssd->front_page0, ssd->front_page1);
+
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  hw->enable = 0;
+  hw->tar = ssd->address;
+  hw->enable = 1;
+
+  dma_channel_transfer_from_buffer_now(ssd->dma_channel, ssd->front_buffer, ssd->front_len);
 }
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
+  // Fora da tela não há byte no buffer nem faixa suja para a página
+  if (x >= ssd->width || y >= ssd->height)
+    return;
+
+  uint16_t index = 1 + x * ssd->pages + (y >> 3);
   uint8_t pixel = (y & 0b111);
   if (value)
     ssd->ram_buffer[index] |= (1 << pixel);
   else
     ssd->ram_buffer[index] &= ~(1 << pixel);
+  ssd1306_mark_dirty(ssd, x, x, y >> 3, y >> 3);
 }
 
-/*
 void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
-
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
-    }
+  // memset do SDK (rotina da ROM) preenche por palavras de 32 bits
+  memset(ssd->ram_buffer + 1, value ? 0xFF : 0x00, ssd->bufsize - 1);
+  ssd1306_mark_dirty(ssd, 0, ssd->width - 1, 0, ssd->pages - 1);
 }
 
-
-
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
-  }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
-  }
+  if (width == 0 || height == 0 || left >= ssd->width || top >= ssd->height)
+    return;
+
+  // Recorta na tela; sem isso right e bottom dariam a volta em 8 bits
+  uint16_t right = left + width - 1;
+  uint16_t bottom = top + height - 1;
+  uint8_t x1 = right < ssd->width ? right : ssd->width - 1;
+  uint8_t y1 = bottom < ssd->height ? bottom : ssd->height - 1;
 
   if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-      }
-    }
+    for (uint8_t x = left; x <= x1; ++x)
+      ssd1306_vline(ssd, x, top, y1, value);
+    return;
   }
+
+  ssd1306_hline(ssd, left, x1, top, value);
+  if (bottom == y1)
+    ssd1306_hline(ssd, left, x1, bottom, value);
+  ssd1306_vline(ssd, left, top, y1, value);
+  if (right == x1)
+    ssd1306_vline(ssd, right, top, y1, value);
 }
 
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
@@ -143,46 +397,117 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 }
 
 
+// Linha horizontal: um único bit por coluna, percorrendo o buffer com passo de uma coluna
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+  if (y >= ssd->height || x0 >= ssd->width || x0 > x1)
+    return;
+  if (x1 >= ssd->width)
+    x1 = ssd->width - 1;
+
+  uint8_t page = y >> 3;
+  uint8_t mask = 1u << (y & 7);
+  uint8_t *col = &ssd->ram_buffer[1 + x0 * ssd->pages + page];
+  for (uint8_t x = x0; x <= x1; ++x, col += ssd->pages) {
+    if (value)
+      *col |= mask;
+    else
+      *col &= ~mask;
+  }
+  ssd1306_mark_dirty(ssd, x0, x1, page, page);
 }
 
+// Linha vertical: as páginas de uma coluna são contíguas, então bastam
+// máscaras nas páginas das pontas e bytes inteiros no meio
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
-}
+  if (x >= ssd->width || y0 >= ssd->height || y0 > y1)
+    return;
+  if (y1 >= ssd->height)
+    y1 = ssd->height - 1;
 
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
-{
-  uint16_t index = 0;
+  uint8_t page0 = y0 >> 3;
+  uint8_t page1 = y1 >> 3;
+  uint8_t *col = &ssd->ram_buffer[1 + x * ssd->pages];
 
-  if (c >= 'A' && c <= 'Z')
-  {
-    index = (c - 'A' + 11) * 8; // Letras maiúsculas
-  }
-  else if (c >= 'a' && c <= 'z')
-  {
-    index = (c - 'a' + 37) * 8; // Letras minúsculas (ajuste no índice)
+  for (uint8_t page = page0; page <= page1; ++page) {
+    uint8_t mask = 0xFF;
+    if (page == page0)
+      mask &= 0xFF << (y0 & 7);
+    if (page == page1)
+      mask &= 0xFF >> (7 - (y1 & 7));
+
+    if (value)
+      col[page] |= mask;
+    else
+      col[page] &= ~mask;
   }
-  else if (c >= '0' && c <= '9')
-  {
-    index = (c - '0' + 1) * 8; // Números
+  ssd1306_mark_dirty(ssd, x, x, page0, page1);
+}
+
+/**
+ * Copia colunas de 8 pixels (bit 0 no topo) para o buffer, sobrescrevendo a área.
+ * Com y múltiplo de 8 cada coluna é uma cópia de byte; caso contrário, cada
+ * coluna é dividida entre duas páginas com deslocamento e máscara.
+ */
+static void ssd1306_blit(ssd1306_t *ssd, const uint8_t *columns, uint8_t count, uint8_t x, uint8_t y) {
+  uint8_t page = y >> 3;
+  uint8_t shift = y & 7;
+  if (page >= ssd->pages || x >= ssd->width)
+    return;
+  if (count > ssd->width - x)
+    count = ssd->width - x;
+
+  uint8_t *col = &ssd->ram_buffer[1 + x * ssd->pages + page];
+
+  if (shift == 0) {
+    for (uint8_t i = 0; i < count; ++i, col += ssd->pages)
+      *col = columns[i];
+    ssd1306_mark_dirty(ssd, x, x + count - 1, page, page);
+    return;
   }
-  else
-  {
-    return; // Ignora caracteres não suportados
+
+  uint8_t low_mask = 0xFF << shift;
+  bool has_high = page + 1 < ssd->pages;
+  for (uint8_t i = 0; i < count; ++i, col += ssd->pages) {
+    col[0] = (col[0] & ~low_mask) | (columns[i] << shift);
+    if (has_high)
+      col[1] = (col[1] & low_mask) | (columns[i] >> (8 - shift));
   }
+  ssd1306_mark_dirty(ssd, x, x + count - 1, page, has_high ? page + 1 : page);
+}
 
-  for (uint8_t i = 0; i < 8; ++i)
-  {
-    uint8_t line = font[index + i];
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+{
+  uint8_t code = (uint8_t)c;
+  if (code < FONT_FIRST_CHAR || code > FONT_LAST_CHAR)
+    return; // Ignora caracteres fora da faixa imprimível
 
-    for (uint8_t j = 0; j < 8; ++j)
-    {
-      ssd1306_pixel(ssd, x + i, y + j, (line >> j) & 1);
-    }
-  }
+  ssd1306_blit(ssd, font_atlas[code - FONT_FIRST_CHAR], FONT_WIDTH, x, y);
+}
+
+/**
+ * Desenha um caractere usando apenas as colunas ocupadas do glifo.
+ * @return Avanço horizontal até o próximo caractere (0 se não suportado)
+ */
+uint8_t ssd1306_draw_char_prop(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+{
+  uint8_t code = (uint8_t)c;
+  if (code < FONT_FIRST_CHAR || code > FONT_LAST_CHAR)
+    return 0;
+
+  uint8_t glyph = code - FONT_FIRST_CHAR;
+  uint8_t ink = font_ink[glyph];
+  if (ink == 0)
+    return FONT_PROP_SPACE_ADVANCE;
+
+  ssd1306_blit(ssd, &font_atlas[glyph][font_left[glyph]], ink, x, y);
+  return ink + FONT_PROP_SPACING;
+}
+
+// Desenha uma string com a fonte proporcional, sem quebra de linha
+void ssd1306_draw_string_prop(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
+{
+  while (*str && x < ssd->width)
+    x += ssd1306_draw_char_prop(ssd, *str++, x, y);
 }
 
 
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""Converte o fluxo binário de telemetria da placa em CSV.
+
+Formato de cada pacote (include/Telemetry.h):
+    0xA5 0x5A tamanho registro[tamanho] checksum_lo checksum_hi
+O checksum Fletcher-16 cobre o byte de tamanho e o registro. A placa só envia
+pacotes com a telemetria ligada (comando "telemetry on" do console); bytes fora
+de pacotes, como o texto do console na mesma serial, são ignorados.
+
+Uso:
+    telemetry_decode.py captura.bin > telemetria.csv
+    telemetry_decode.py --port /dev/ttyACM0 --enable > telemetria.csv   (requer pyserial)
+
+Com --enable o decodificador liga a telemetria ao abrir a porta e a desliga ao sair.
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+SYNC = b"\xa5\x5a"
+HEADER = struct.Struct("<IB")       # timeUs, zone
+TRAILER = struct.Struct("<BBB")     # control, severity, flags
+QUANTITIES = ["temperature", "humidity", "brightness"]
+SEVERITIES = ["normal", "warning", "critical"]
+
+FLAG_SOUND_ALERT = 0x01
+FLAG_DROPPED = 0x02
+
+
+def fletcher16(data):
+    sum1 = sum2 = 0
+    for byte in data:
+        sum1 = (sum1 + byte) % 255
+        sum2 = (sum2 + sum1) % 255
+    return (sum2 << 8) | sum1
+
+
+def frames(chunks):
+    """Extrai os registros válidos de uma sequência de blocos de bytes."""
+    buffer = bytearray()
+    for chunk in chunks:
+        buffer.extend(chunk)
+        while True:
+            start = buffer.find(SYNC)
+            if start < 0:
+                # Mantém um possível primeiro byte de sincronismo no fim
+                del buffer[:-1]
+                break
+            del buffer[:start]
+            if len(buffer) < 3:
+                break
+            size = buffer[2]
+            total = 3 + size + 2
+            if len(buffer) < total:
+                break
+            checksum = buffer[3 + size] | (buffer[4 + size] << 8)
+            if size >= HEADER.size + TRAILER.size and fletcher16(buffer[2:3 + size]) == checksum:
+                yield bytes(buffer[3:3 + size])
+                del buffer[:total]
+            else:
+                # Sincronismo falso ou pacote corrompido: procura o próximo
+                del buffer[:1]
+
+
+def decode(record):
+    time_us, zone = HEADER.unpack_from(record, 0)
+    count = len(record) - HEADER.size - TRAILER.size
+    values = list(record[HEADER.size:HEADER.size + count])
+    control, severity, flags = TRAILER.unpack_from(record, HEADER.size + count)
+    return time_us, zone, values, control, severity, flags
+
+
+def column_names(count):
+    return [QUANTITIES[i] if i < len(QUANTITIES) else "quantity%d" % i for i in range(count)]
+
+
+def read_file(path):
+    stream = sys.stdin.buffer if path == "-" else open(path, "rb")
+    with stream:
+        while True:
+            chunk = stream.read(4096)
+            if not chunk:
+                return
+            yield chunk
+
+
+def read_port(port, baud, enable):
+    import serial
+    with serial.Serial(port, baud, timeout=1) as link:
+        if enable:
+            link.write(b"telemetry on\n")
+        try:
+            while True:
+                yield link.read(link.in_waiting or 1)
+        finally:
+            if enable:
+                link.write(b"telemetry off\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", nargs="?", default="-", help="arquivo capturado ('-' para a entrada padrão)")
+    parser.add_argument("--port", help="porta serial da placa")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--enable", action="store_true", help="liga a telemetria na placa enquanto lê a porta")
+    args = parser.parse_args()
+
+    chunks = read_port(args.port, args.baud, args.enable) if args.port else read_file(args.input)
+    writer = csv.writer(sys.stdout)
+    header_count = None
+
+    try:
+        for record in frames(chunks):
+            time_us, zone, values, control, severity, flags = decode(record)
+            if header_count != len(values):
+                header_count = len(values)
+                names = column_names(header_count)
+                writer.writerow(["time_us", "zone"] + names + ["control", "severity", "sound_alert", "dropped_before"])
+                names.append("none")
+            writer.writerow([
+                time_us,
+                zone + 1,
+                *values,
+                names[control] if control < len(names) else control,
+                SEVERITIES[severity] if severity < len(SEVERITIES) else severity,
+                int(bool(flags & FLAG_SOUND_ALERT)),
+                int(bool(flags & FLAG_DROPPED)),
+            ])
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        chunks.close()
+
+
+if __name__ == "__main__":
+    main()